@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "outBuffer.h"
+
+void outInit(OutBuffer * out, int fd){
+	out->fd = fd;
+	out->used = 0;
+	out->spill = NULL;
+	out->spilled = 0;
+	out->spillCapacity = 0;
+	out->lost = 0;
+}
+
+// Moves the buffered text onto the end of a memory buffer's block, doubling it as needed.
+static int outSpill(OutBuffer * out){
+	if(out->spill == NULL || out->spilled + out->used > out->spillCapacity){
+		size_t capacity = (out->spillCapacity == 0) ? OUT_BUFFER_SIZE : out->spillCapacity * 2;
+
+		while(capacity < out->spilled + out->used){
+			capacity *= 2;
+		}
+
+		char * spill = realloc(out->spill, capacity);
+
+		if(spill == NULL){
+			out->used = 0;
+			out->lost = 1;
+			return -1;
+		}
+
+		out->spill = spill;
+		out->spillCapacity = capacity;
+	}
+
+	memcpy(out->spill + out->spilled, out->data, out->used);
+	out->spilled += out->used;
+	out->used = 0;
+
+	return 0;
+}
+
+int outFlush(OutBuffer * out){
+	size_t done = 0;
+
+	if(out->fd == OUT_MEMORY){
+		return outSpill(out);
+	}
+
+	while(done < out->used){
+		ssize_t written = write(out->fd, out->data + done, out->used - done);
+
+		if(written < 0 && errno == EINTR) continue;
+
+		if(written <= 0){
+			out->used = 0;
+			return -1;
+		}
+
+		done += written;
+	}
+
+	out->used = 0;
+
+	return 0;
+}
+
+char * outTake(OutBuffer * out, size_t * length){
+	int lost = (outSpill(out) < 0 || out->lost);
+	char * text = out->spill;
+
+	*length = out->spilled;
+	out->spill = NULL;
+	out->spilled = 0;
+	out->spillCapacity = 0;
+	out->lost = 0;
+
+	if(lost){
+		free(text);
+		*length = 0;
+		return NULL;
+	}
+
+	return text;
+}
+
+void outChar(OutBuffer * out, char c){
+	if(out->used == OUT_BUFFER_SIZE){
+		outFlush(out);
+	}
+
+	out->data[out->used++] = c;
+}
+
+void outBytes(OutBuffer * out, const char * bytes, size_t length){
+	while(length > 0){
+		if(out->used == OUT_BUFFER_SIZE){
+			outFlush(out);
+		}
+
+		size_t room = OUT_BUFFER_SIZE - out->used;
+		size_t n = (length < room) ? length : room;
+
+		memcpy(out->data + out->used, bytes, n);
+		out->used += n;
+		bytes += n;
+		length -= n;
+	}
+}
+
+void outText(OutBuffer * out, const char * text){
+	outBytes(out, text, strlen(text));
+}
+
+// Writes the digits of value, least significant first into the end of a scratch array.
+static void outUnsigned(OutBuffer * out, unsigned long long value){
+	char digits[20];
+	int i = sizeof(digits);
+
+	do{
+		digits[--i] = '0' + value % 10;
+		value /= 10;
+	}while(value != 0);
+
+	outBytes(out, digits + i, sizeof(digits) - i);
+}
+
+void outInt(OutBuffer * out, long long value){
+	if(value < 0){
+		outChar(out, '-');
+		outUnsigned(out, 0ULL - (unsigned long long) value);
+		return;
+	}
+
+	outUnsigned(out, value);
+}
+
+void outFixed2(OutBuffer * out, float value){
+	uint32_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+
+	int exponent = (bits >> 23) & 0xff;
+	uint64_t mantissa = bits & 0x7fffff;
+
+	// The value is mantissa * 2^shift exactly. Anything too large to scale by 100 in 64 bits,
+	// along with inf and nan, goes through snprintf instead.
+	if(exponent == 0xff || exponent > 150 + 30){
+		char text[64];
+		int length = snprintf(text, sizeof(text), "%.2f", value);
+
+		outBytes(out, text, (length < (int) sizeof(text)) ? length : (int) sizeof(text) - 1);
+		return;
+	}
+
+	int shift = (exponent == 0) ? -149 : exponent - 150;
+	uint64_t hundredths;
+
+	if(exponent != 0){
+		mantissa |= 1 << 23;
+	}
+
+	if(shift >= 0){
+		hundredths = (mantissa * 100) << shift;
+	}else if(shift <= -63){
+		// mantissa * 100 is below 2^31, so this is less than half a hundredth
+		hundredths = 0;
+	}else{
+		// Divide mantissa * 100 by 2^-shift, rounding half to even as printf does
+		uint64_t scaled = mantissa * 100;
+		uint64_t half = 1ULL << (-shift - 1);
+		uint64_t remainder = scaled & ((half << 1) - 1);
+
+		hundredths = scaled >> -shift;
+
+		if(remainder > half || (remainder == half && (hundredths & 1))){
+			hundredths++;
+		}
+	}
+
+	if(bits & 0x80000000u){
+		outChar(out, '-');
+	}
+
+	outUnsigned(out, hundredths / 100);
+	outChar(out, '.');
+	outChar(out, '0' + (hundredths / 10) % 10);
+	outChar(out, '0' + hundredths % 10);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+
+#define OUT_BUFFER_SIZE 65536
+
+/*
+    Output gathered into a fixed buffer and handed to write(2) a buffer at a time, with
+    formatters for the few conversions the printers need. Nothing is allocated, and the
+    text produced is byte for byte what printf would have produced.
+
+    It bypasses stdio, so a printer that mixes the two must fflush(stdout) before its first
+    outFlush and flush its OutBuffer before going back to printf.
+
+    Initialized with OUT_MEMORY instead of a descriptor, a buffer collects its text in a
+    growing block of memory instead, to be taken with outTake. That lets threads format
+    output privately and have it written out in whatever order the program needs.
+*/
+#define OUT_MEMORY -1
+
+typedef struct outBuffer
+{
+	int fd;
+	size_t used;
+	char* spill;
+	size_t spilled;
+	size_t spillCapacity;
+	int lost;
+	char data[OUT_BUFFER_SIZE];
+} OutBuffer;
+
+void outInit(OutBuffer* out, int fd);
+
+/*
+    writes out everything buffered; returns -1 if the descriptor refused it,
+    or in memory the block could not grow, in which case the buffered text is dropped
+*/
+int outFlush(OutBuffer* out);
+
+/*
+    memory buffers only: returns everything collected since the last outTake as a
+    malloc'd block the caller frees, with its size in *length; NULL if any was lost
+*/
+char* outTake(OutBuffer* out, size_t* length);
+
+void outChar(OutBuffer* out, char c);
+
+/*
+    outText takes a NUL-terminated string, outBytes a length
+*/
+void outText(OutBuffer* out, const char* text);
+void outBytes(OutBuffer* out, const char* bytes, size_t length);
+
+/*
+    printf's %d and %lld
+*/
+void outInt(OutBuffer* out, long long value);
+
+/*
+    printf's %.2f for a float, rounded from its exact binary value the way printf rounds it
+*/
+void outFixed2(OutBuffer* out, float value);
@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "batch.h"
+
+static int pieceTotal(Piece * piece){
+	return piece == NULL ? 0 : piece->total;
+}
+
+static void piecePull(Piece * piece){
+	piece->total = piece->length + pieceTotal(piece->left) + pieceTotal(piece->right);
+}
+
+static Piece * newPiece(int start, int length, Entry * entry){
+	Piece * piece = (Piece *) malloc(sizeof(Piece));
+
+	if(piece == NULL) return NULL;
+
+	piece->start = start;
+	piece->length = length;
+	piece->entry = entry;
+	piece->priority = rand();
+	piece->left = NULL;
+	piece->right = NULL;
+	piecePull(piece);
+
+	return piece;
+}
+
+static void freePieces(Piece * piece){
+	if(piece == NULL) return;
+
+	freePieces(piece->left);
+	freePieces(piece->right);
+	free(piece);
+}
+
+static Piece * pieceMerge(Piece * a, Piece * b){
+	if(a == NULL) return b;
+	if(b == NULL) return a;
+
+	if(a->priority > b->priority){
+		a->right = pieceMerge(a->right, b);
+		piecePull(a);
+		return a;
+	}
+
+	b->left = pieceMerge(a, b->left);
+	piecePull(b);
+	return b;
+}
+
+/*
+    Splits off the first k entries into l and the rest into r. A run that straddles the
+    split is cut in two, and the second half goes into *spare, which is then used up.
+*/
+static void pieceSplit(Piece * piece, int k, Piece ** l, Piece ** r, Piece ** spare){
+	if(piece == NULL){
+		*l = NULL;
+		*r = NULL;
+		return;
+	}
+
+	int leftTotal = pieceTotal(piece->left);
+
+	if(k <= leftTotal){
+		pieceSplit(piece->left, k, l, &piece->left, spare);
+		piecePull(piece);
+		*r = piece;
+	}else if(k >= leftTotal + piece->length){
+		pieceSplit(piece->right, k - leftTotal - piece->length, &piece->right, r, spare);
+		piecePull(piece);
+		*l = piece;
+	}else{
+		int cut = k - leftTotal;
+		Piece * rest = *spare;
+
+		*spare = NULL;
+		rest->start = piece->start + cut;
+		rest->length = piece->length - cut;
+		piecePull(rest);
+
+		piece->length = cut;
+		*r = pieceMerge(rest, piece->right);
+		piece->right = NULL;
+		piecePull(piece);
+		*l = piece;
+	}
+}
+
+Batch * initializeBatch(){
+	Batch * batch = (Batch *) malloc(sizeof(Batch));
+
+	if(batch == NULL){
+		printf("Unable to allocate memory for batch.\n");
+		return NULL;
+	}
+
+	batch->root = NULL;
+	batch->pending = 0;
+	batch->size = 0;
+	batch->capacity = 0;
+	batch->reallocs = 0;
+
+	return batch;
+}
+
+void deleteBatch(Batch * batch){
+	if(batch == NULL) return;
+
+	freePieces(batch->root);
+	free(batch);
+}
+
+// Starts buffering against the list as it stands: one run covering every entry.
+static int beginBatch(Batch * batch, List * myList){
+	if(batch->pending) return 0;
+
+	batch->root = NULL;
+
+	if(myList->size > 0 && (batch->root = newPiece(0, myList->size, NULL)) == NULL){
+		return -1;
+	}
+
+	batch->pending = 1;
+	batch->size = myList->size;
+	batch->capacity = myList->capacity;
+	batch->reallocs = myList->reallocs;
+
+	return 0;
+}
+
+int batchSize(Batch * batch, List * myList){
+	return batch->pending ? batch->size : myList->size;
+}
+
+void batchInsert(Batch * batch, List * myList, int position, char * name, char * lastname, float height, int age){
+	if(myList == NULL || myList->backend != LIST_RING){
+		insertToPosition(myList, position, name, lastname, height, age);
+		return;
+	}
+
+	int size = batchSize(batch, myList);
+
+	if(position < 0 || position > size){
+		printf("Cannot insert at position: %d. Invalid position.\n", position);
+		return;
+	}
+
+	Piece * item = newPiece(-1, 1, NULL);
+	Piece * spare = newPiece(-1, 0, NULL);
+
+	// Without room to buffer the edit, apply it directly instead
+	if(item == NULL || spare == NULL || beginBatch(batch, myList) < 0){
+		free(item);
+		free(spare);
+
+		if(flushBatch(batch, myList) == 0){
+			insertToPosition(myList, position, name, lastname, height, age);
+		}
+		return;
+	}
+
+	item->entry = listNewEntry(myList, name, lastname, height, age);
+
+	if(item->entry == NULL){
+		free(item);
+		free(spare);
+		return;
+	}
+
+	if(batch->size == batch->capacity){
+		batch->capacity = growTarget(myList, batch->capacity);
+		batch->reallocs++;
+	}
+
+	Piece * l;
+	Piece * r;
+
+	pieceSplit(batch->root, position, &l, &r, &spare);
+	batch->root = pieceMerge(pieceMerge(l, item), r);
+	batch->size++;
+	free(spare);
+}
+
+void batchDelete(Batch * batch, List * myList, int position){
+	if(myList == NULL || myList->backend != LIST_RING){
+		deleteFromPosition(myList, position);
+		return;
+	}
+
+	int size = batchSize(batch, myList);
+
+	if(size == 0){
+		printf("No entries in the list to delete.\n");
+		return;
+	}
+
+	if(position < 0 || position >= size){
+		printf("Deletion position out of bounds.\n");
+		return;
+	}
+
+	Piece * before = newPiece(-1, 0, NULL);
+	Piece * after = newPiece(-1, 0, NULL);
+
+	if(before == NULL || after == NULL || beginBatch(batch, myList) < 0){
+		free(before);
+		free(after);
+
+		if(flushBatch(batch, myList) == 0){
+			deleteFromPosition(myList, position);
+		}
+		return;
+	}
+
+	Piece * l;
+	Piece * m;
+	Piece * r;
+
+	// Isolate the one entry at position; an entry from the original list is simply left
+	// out of every run, and the flush releases it
+	pieceSplit(batch->root, position, &l, &r, &before);
+	pieceSplit(r, 1, &m, &r, &after);
+
+	if(m->start == -1){
+		listReleaseEntry(myList, m->entry);
+	}
+
+	free(m);
+	free(before);
+	free(after);
+	batch->root = pieceMerge(l, r);
+	batch->size--;
+
+	int cap = shrinkTarget(myList, batch->size, batch->capacity);
+
+	if(cap != batch->capacity){
+		batch->capacity = cap;
+		batch->reallocs++;
+	}
+}
+
+typedef struct flushState
+{
+	List* list;
+	Entry** data;
+	int out;
+	int next;
+} FlushState;
+
+// Copies the pieces into the new ring in order. Runs come out in increasing order of
+// their start, so any original entry skipped between two runs was deleted.
+static void applyPieces(Piece * piece, FlushState * state){
+	if(piece == NULL) return;
+
+	applyPieces(piece->left, state);
+
+	if(piece->start == -1){
+		state->data[state->out++] = piece->entry;
+	}else{
+		for(; state->next < piece->start; state->next++){
+			listReleaseEntry(state->list, listGet(state->list, state->next));
+		}
+
+		for(; state->next < piece->start + piece->length; state->next++){
+			state->data[state->out++] = listGet(state->list, state->next);
+		}
+	}
+
+	applyPieces(piece->right, state);
+}
+
+int flushBatch(Batch * batch, List * myList){
+	if(!batch->pending) return 0;
+
+	FlushState state;
+
+	state.list = myList;
+	state.data = (Entry **) malloc(sizeof(Entry *) * batch->capacity);
+	state.out = 0;
+	state.next = 0;
+
+	if(state.data == NULL){
+		printf("Unable to apply batched edits.\n");
+		return -1;
+	}
+
+	applyPieces(batch->root, &state);
+
+	for(; state.next < myList->size; state.next++){
+		listReleaseEntry(myList, listGet(myList, state.next));
+	}
+
+	listAdoptRing(myList, state.data, batch->size, batch->capacity);
+	myList->reallocs = batch->reallocs;
+
+	freePieces(batch->root);
+	batch->root = NULL;
+	batch->pending = 0;
+
+	return 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "list.h"
+
+/*
+    A piece of the list as it will look once the pending edits are applied: either a run
+    of `length` entries that were in the list when the batch started, beginning at logical
+    index `start`, or a single entry inserted since (start is -1). Pieces are nodes of an
+    implicit treap ordered by position and counting the entries below them.
+*/
+typedef struct piece
+{
+	int start;
+	int length;
+	Entry* entry;
+	int total;
+	unsigned priority;
+	struct piece* left;
+	struct piece* right;
+} Piece;
+
+/*
+    Positional inserts and deletes buffered against a ring list. size, capacity and
+    reallocs track what the list would report had each edit been applied on its own,
+    so the capacity policy makes the same decisions it would have made.
+*/
+typedef struct batch
+{
+	Piece* root;
+	int pending;
+	int size;
+	int capacity;
+	int reallocs;
+} Batch;
+
+Batch* initializeBatch();
+
+/*
+    frees the batch itself; flush it first or the pending edits are lost
+*/
+void deleteBatch(Batch* batch);
+
+/*
+    same checks and messages as insertToPosition and deleteFromPosition
+*/
+void batchInsert(Batch* batch, List* myList, int position, char* name, char* lastname, float height, int age);
+void batchDelete(Batch* batch, List* myList, int position);
+
+/*
+    the size the list will have once the pending edits are applied
+*/
+int batchSize(Batch* batch, List* myList);
+
+/*
+    Applies every pending edit in one merge pass over the ring.
+    returns -1, keeping the edits pending, if the new ring cannot be allocated
+*/
+int flushBatch(Batch* batch, List* myList);
@@ -0,0 +1,214 @@
+// Benchmark harness for the PA1 interpreter: generates seeded command traces for each
+// command mix and position distribution, runs the interpreter on them, and reports
+// throughput, peak memory and the realloc count the list reports at the end.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "traceGen.h"
+
+typedef struct benchResult
+{
+	double seconds;
+	long peakKb;
+	int reallocs;
+	int status;
+} BenchResult;
+
+void printUsage(char* program)
+{
+	fprintf(stderr, "Usage: %s [-m mix] [-d head|tail|uniform] [-n ops] [-s initial size] [-r seed] [-t] <program> [program args...]\n", program);
+	fprintf(stderr, "  -t writes the trace to stdout instead of running the program\n");
+	fprintf(stderr, "  mixes:");
+
+	for (const TraceMix* mix = traceMixes; mix->name != NULL; mix++)
+	{
+		fprintf(stderr, " %s", mix->name);
+	}
+
+	fprintf(stderr, "\n");
+}
+
+// Runs the program on the trace with its output piped back, keeping the last
+// printListInfo line for the realloc count.
+int runTrace(char** argv, int argc, char* tracePath, BenchResult* result)
+{
+	int pipeFds[2];
+	char** args = (char**) malloc(sizeof(char*) * (argc + 2));
+
+	if (args == NULL || pipe(pipeFds) < 0)
+	{
+		free(args);
+		return -1;
+	}
+
+	memcpy(args, argv, sizeof(char*) * argc);
+	args[argc] = tracePath;
+	args[argc + 1] = NULL;
+
+	struct timespec start;
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	pid_t pid = fork();
+
+	if (pid == 0)
+	{
+		dup2(pipeFds[1], STDOUT_FILENO);
+		close(pipeFds[0]);
+		close(pipeFds[1]);
+		execv(args[0], args);
+		_exit(127);
+	}
+
+	free(args);
+	close(pipeFds[1]);
+
+	if (pid < 0)
+	{
+		close(pipeFds[0]);
+		return -1;
+	}
+
+	FILE* output = fdopen(pipeFds[0], "r");
+	char line[256];
+	struct rusage usage;
+
+	result->reallocs = -1;
+
+	while (fgets(line, sizeof(line), output) != NULL)
+	{
+		int size, capacity, reallocs;
+
+		if (sscanf(line, "size:%d, capacity:%d, reallocs:%d", &size, &capacity, &reallocs) == 3)
+		{
+			result->reallocs = reallocs;
+		}
+	}
+
+	fclose(output);
+	wait4(pid, &result->status, 0, &usage);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	result->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	result->peakKb = usage.ru_maxrss;
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	const TraceMix* onlyMix = NULL;
+	int onlyDistribution = -1;
+	int traceOnly = 0;
+	TraceSpec spec = { NULL, DIST_UNIFORM, 100000, 10000, 1 };
+	int opt;
+
+	// + stops at the program so its own options are passed through untouched
+	while ((opt = getopt(argc, argv, "+m:d:n:s:r:t")) != -1)
+	{
+		if (opt == 'm' && (onlyMix = findMix(optarg)) != NULL) continue;
+		if (opt == 'd' && (onlyDistribution = parseDistribution(optarg)) >= 0) continue;
+
+		if (opt == 'n')
+		{
+			spec.ops = atoi(optarg);
+		}
+		else if (opt == 's')
+		{
+			spec.initialSize = atoi(optarg);
+		}
+		else if (opt == 'r')
+		{
+			spec.seed = strtoull(optarg, NULL, 10);
+		}
+		else if (opt == 't')
+		{
+			traceOnly = 1;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (traceOnly)
+	{
+		spec.mix = (onlyMix != NULL) ? onlyMix : findMix("mixed");
+		spec.distribution = (onlyDistribution >= 0) ? onlyDistribution : DIST_UNIFORM;
+		writeTrace(stdout, &spec);
+		return 0;
+	}
+
+	if (optind >= argc)
+	{
+		printUsage(argv[0]);
+		return -1;
+	}
+
+	char tracePath[] = "/tmp/pa1traceXXXXXX";
+	int traceFd = mkstemp(tracePath);
+
+	if (traceFd < 0)
+	{
+		fprintf(stderr, "Unable to create a trace file.\n");
+		return -1;
+	}
+
+	close(traceFd);
+
+	printf("%-8s %-8s %10s %10s %9s %12s %10s %9s\n", "mix", "dist", "ops", "initial", "seconds", "ops/sec", "peakKB", "reallocs");
+
+	for (const TraceMix* mix = traceMixes; mix->name != NULL; mix++)
+	{
+		if (onlyMix != NULL && mix != onlyMix) continue;
+
+		for (int distribution = DIST_HEAD; distribution <= DIST_UNIFORM; distribution++)
+		{
+			if (onlyDistribution >= 0 && distribution != onlyDistribution) continue;
+
+			FILE* trace = fopen(tracePath, "w");
+			BenchResult result;
+
+			if (trace == NULL)
+			{
+				fprintf(stderr, "Unable to write %s.\n", tracePath);
+				unlink(tracePath);
+				return -1;
+			}
+
+			spec.mix = mix;
+			spec.distribution = distribution;
+			writeTrace(trace, &spec);
+			fclose(trace);
+
+			if (runTrace(argv + optind, argc - optind, tracePath, &result) < 0)
+			{
+				fprintf(stderr, "Unable to run %s.\n", argv[optind]);
+				unlink(tracePath);
+				return -1;
+			}
+
+			if (!WIFEXITED(result.status) || WEXITSTATUS(result.status) != 0)
+			{
+				fprintf(stderr, "%s failed on the %s/%s trace.\n", argv[optind], mix->name, distributionName(distribution));
+			}
+
+			// Every command counts, the initial inserts included
+			long commands = (long) spec.ops + spec.initialSize + 2;
+
+			printf("%-8s %-8s %10d %10d %9.3f %12.0f %10ld %9d\n", mix->name, distributionName(distribution),
+				spec.ops, spec.initialSize, result.seconds, commands / result.seconds, result.peakKb, result.reallocs);
+			fflush(stdout);
+		}
+	}
+
+	unlink(tracePath);
+
+	return 0;
+}
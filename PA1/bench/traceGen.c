@@ -0,0 +1,138 @@
+#include <string.h>
+#include "traceGen.h"
+
+const TraceMix traceMixes[] = {
+	{ "fill", 100, 0, 0, 0 },
+	{ "churn", 50, 50, 0, 0 },
+	{ "lookup", 10, 10, 80, 0 },
+	{ "mixed", 40, 30, 25, 5 },
+	{ NULL, 0, 0, 0, 0 }
+};
+
+static const char * distributionNames[] = { "head", "tail", "uniform" };
+
+const TraceMix * findMix(const char * name){
+	for(const TraceMix * mix = traceMixes; mix->name != NULL; mix++){
+		if(strcmp(mix->name, name) == 0) return mix;
+	}
+
+	return NULL;
+}
+
+int parseDistribution(const char * name){
+	for(int i = 0; i < 3; i++){
+		if(strcmp(distributionNames[i], name) == 0) return i;
+	}
+
+	return -1;
+}
+
+const char * distributionName(int distribution){
+	return distributionNames[distribution];
+}
+
+// xorshift64*, so a seed gives the same trace on every libc
+static uint64_t nextRandom(uint64_t * state){
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+
+	return *state * 2685821657736338717ULL;
+}
+
+// A uniform double in [0, 1)
+static double nextUnit(uint64_t * state){
+	return (nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Five lowercase letters picked by the number, so a find can name an earlier insert
+static void makeName(uint64_t number, char * name){
+	uint64_t state = number * 0x9e3779b97f4a7c15ULL + 1;
+
+	for(int i = 0; i < 5; i++){
+		name[i] = 'a' + nextRandom(&state) % 26;
+	}
+
+	name[5] = '\0';
+}
+
+// A position in [0, size], skewed towards whichever end the distribution favours
+static int pickPosition(uint64_t * state, int distribution, int size){
+	double u = nextUnit(state);
+
+	if(distribution != DIST_UNIFORM){
+		u = u * u * u;
+	}
+
+	int position = (int) (u * (size + 1));
+
+	if(position > size) position = size;
+
+	return (distribution == DIST_TAIL) ? size - position : position;
+}
+
+static void writeInsert(FILE * out, uint64_t * state, int position, int size, uint64_t number){
+	char name[6];
+	char lastname[6];
+	double height = 1.0 + (nextRandom(state) % 100) / 100.0;
+	int age = 1 + nextRandom(state) % 90;
+
+	makeName(number, name);
+	makeName(number ^ 0xffffffffULL, lastname);
+
+	if(position == 0){
+		fprintf(out, "insertToHead %s %s %.2f %d\n", name, lastname, height, age);
+	}else if(position == size){
+		fprintf(out, "insertToTail %s %s %.2f %d\n", name, lastname, height, age);
+	}else{
+		fprintf(out, "insertToPosition %d %s %s %.2f %d\n", position, name, lastname, height, age);
+	}
+}
+
+void writeTrace(FILE * out, const TraceSpec * spec){
+	const TraceMix * mix = spec->mix;
+	uint64_t state = spec->seed * 0x9e3779b97f4a7c15ULL + 0x2545f4914f6cdd1dULL;
+	uint64_t inserted = 0;
+	int size = 0;
+	int total = mix->insert + mix->delete + mix->find + mix->info;
+
+	for(; size < spec->initialSize; size++){
+		writeInsert(out, &state, size, size, inserted++);
+	}
+
+	for(int i = 0; i < spec->ops; i++){
+		int pick = nextRandom(&state) % total;
+
+		if(pick < mix->insert){
+			writeInsert(out, &state, pickPosition(&state, spec->distribution, size), size, inserted++);
+			size++;
+		}else if((pick -= mix->insert) < mix->delete){
+			if(size == 0){
+				fprintf(out, "deleteFromHead\n");
+				continue;
+			}
+
+			int position = pickPosition(&state, spec->distribution, size - 1);
+
+			if(position == 0){
+				fprintf(out, "deleteFromHead\n");
+			}else if(position == size - 1){
+				fprintf(out, "deleteFromTail\n");
+			}else{
+				fprintf(out, "deleteFromPosition %d\n", position);
+			}
+
+			size--;
+		}else if((pick -= mix->delete) < mix->find){
+			char name[6];
+
+			// Any name inserted so far, whether or not it has been deleted since
+			makeName(inserted ? nextRandom(&state) % inserted : 0, name);
+			fprintf(out, "findPosition %s\n", name);
+		}else{
+			fprintf(out, "printListInfo\n");
+		}
+	}
+
+	fprintf(out, "printListInfo\ndeleteList\n");
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Where positional commands land: near the head, near the tail, or anywhere
+#define DIST_HEAD 0
+#define DIST_TAIL 1
+#define DIST_UNIFORM 2
+
+/*
+    Relative weights of the command kinds in a trace. Inserts and deletes pick their
+    position from the trace's distribution and use insertToHead/insertToTail (or the
+    matching delete) when it lands on an end, as input3.txt does.
+*/
+typedef struct traceMix
+{
+	const char* name;
+	int insert;
+	int delete;
+	int find;
+	int info;
+} TraceMix;
+
+typedef struct traceSpec
+{
+	const TraceMix* mix;
+	int distribution;
+	int ops;
+	int initialSize;
+	uint64_t seed;
+} TraceSpec;
+
+/*
+    returns the mix with the given name, or NULL
+*/
+const TraceMix* findMix(const char* name);
+
+/*
+    the built-in mixes, ending with an entry whose name is NULL
+*/
+extern const TraceMix traceMixes[];
+
+/*
+    returns DIST_HEAD, DIST_TAIL or DIST_UNIFORM for head, tail or uniform, or -1
+*/
+int parseDistribution(const char* name);
+const char* distributionName(int distribution);
+
+/*
+    Writes initialSize insertToTail commands and then ops commands drawn from the mix,
+    followed by printListInfo and deleteList. The same spec always writes the same trace.
+*/
+void writeTrace(FILE* out, const TraceSpec* spec);
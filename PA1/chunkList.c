@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+
+static int chunkTotal(Chunk * node){
+	return node == NULL ? 0 : node->total;
+}
+
+static int chunkChunks(Chunk * node){
+	return node == NULL ? 0 : node->chunkCount;
+}
+
+// Points the entries at offsets [from, count) of a chunk back at that chunk.
+static void claimItems(Chunk * node, int from){
+	for(int i = from; i < node->count; i++){
+		node->items->slots[i]->where.chunk = node;
+	}
+}
+
+// Recomputes the subtree counts of a node from its children and re-links their parents.
+static void chunkPull(Chunk * node){
+	node->total = node->count + chunkTotal(node->left) + chunkTotal(node->right);
+	node->chunkCount = 1 + chunkChunks(node->left) + chunkChunks(node->right);
+
+	if(node->left != NULL) node->left->parent = node;
+	if(node->right != NULL) node->right->parent = node;
+}
+
+// Refreshes the counts of a node and every ancestor after its chunk changed size.
+static void chunkFixUp(Chunk * node){
+	while(node != NULL){
+		chunkPull(node);
+		node = node->parent;
+	}
+}
+
+void chunkItemsRetain(ChunkItems * items){
+	__atomic_add_fetch(&items->refs, 1, __ATOMIC_RELAXED);
+}
+
+void chunkItemsRelease(ChunkItems * items){
+	if(__atomic_sub_fetch(&items->refs, 1, __ATOMIC_ACQ_REL) == 0){
+		free(items);
+	}
+}
+
+static ChunkItems * newChunkItems(){
+	ChunkItems * items = (ChunkItems *) malloc(sizeof(ChunkItems));
+
+	if(items == NULL){
+		printf("Unable to allocate memory for chunk.\n");
+		return NULL;
+	}
+
+	items->refs = 1;
+
+	return items;
+}
+
+// Copy-on-write: gives a chunk whose items a snapshot still shares a private copy to edit.
+static int chunkOwn(Chunk * node){
+	if(__atomic_load_n(&node->items->refs, __ATOMIC_ACQUIRE) == 1){
+		return 0;
+	}
+
+	ChunkItems * items = newChunkItems();
+
+	if(items == NULL) return -1;
+
+	memcpy(items->slots, node->items->slots, sizeof(struct entry *) * node->count);
+	chunkItemsRelease(node->items);
+	node->items = items;
+
+	return 0;
+}
+
+static void freeChunk(Chunk * node){
+	chunkItemsRelease(node->items);
+	free(node);
+}
+
+static Chunk * newChunk(){
+	Chunk * node = (Chunk *) calloc(1, sizeof(Chunk));
+
+	if(node == NULL){
+		printf("Unable to allocate memory for chunk.\n");
+		return NULL;
+	}
+
+	if((node->items = newChunkItems()) == NULL){
+		free(node);
+		return NULL;
+	}
+
+	node->priority = rand();
+	chunkPull(node);
+
+	return node;
+}
+
+static Chunk * chunkMerge(Chunk * a, Chunk * b){
+	if(a == NULL) return b;
+	if(b == NULL) return a;
+
+	if(a->priority > b->priority){
+		a->right = chunkMerge(a->right, b);
+		chunkPull(a);
+		return a;
+	}
+
+	b->left = chunkMerge(a, b->left);
+	chunkPull(b);
+	return b;
+}
+
+// Splits off the first k chunks of a subtree into l and the rest into r.
+static void chunkSplit(Chunk * node, int k, Chunk ** l, Chunk ** r){
+	if(node == NULL){
+		*l = NULL;
+		*r = NULL;
+		return;
+	}
+
+	int leftChunks = chunkChunks(node->left);
+
+	if(k <= leftChunks){
+		chunkSplit(node->left, k, l, &node->left);
+		chunkPull(node);
+		*r = node;
+	}else{
+		chunkSplit(node->right, k - leftChunks - 1, &node->right, r);
+		chunkPull(node);
+		*l = node;
+	}
+}
+
+static void setRoot(ChunkTree * tree, Chunk * root){
+	tree->root = root;
+
+	if(root != NULL){
+		root->parent = NULL;
+	}
+}
+
+/*
+    Finds the chunk holding a logical position along with the offset inside that chunk
+    and the chunk's own index. With inclusiveEnd set, the position one past a chunk's
+    last entry also belongs to that chunk, which is what insertion needs.
+*/
+static Chunk * chunkLocate(Chunk * node, int position, int inclusiveEnd, int * offset, int * index){
+	int chunkIndex = 0;
+
+	while(node != NULL){
+		int leftTotal = chunkTotal(node->left);
+
+		if(position < leftTotal){
+			node = node->left;
+		}else if(position < leftTotal + node->count || (inclusiveEnd && position == leftTotal + node->count)){
+			*offset = position - leftTotal;
+			*index = chunkIndex + chunkChunks(node->left);
+			return node;
+		}else{
+			position -= leftTotal + node->count;
+			chunkIndex += chunkChunks(node->left) + 1;
+			node = node->right;
+		}
+	}
+
+	return NULL;
+}
+
+static void chunkInsertAfter(ChunkTree * tree, int index, Chunk * node){
+	Chunk * l;
+	Chunk * r;
+
+	chunkSplit(tree->root, index + 1, &l, &r);
+	setRoot(tree, chunkMerge(chunkMerge(l, node), r));
+	tree->chunks++;
+	tree->resizes++;
+}
+
+static void chunkRemoveAt(ChunkTree * tree, int index){
+	Chunk * l;
+	Chunk * m;
+	Chunk * r;
+
+	chunkSplit(tree->root, index, &l, &r);
+	chunkSplit(r, 1, &m, &r);
+	freeChunk(m);
+	setRoot(tree, chunkMerge(l, r));
+	tree->chunks--;
+	tree->resizes++;
+}
+
+ChunkTree * initializeChunkTree(){
+	ChunkTree * tree = (ChunkTree *) malloc(sizeof(ChunkTree));
+
+	if(tree == NULL){
+		printf("Unable to allocate memory for chunk tree.\n");
+		return NULL;
+	}
+
+	tree->root = NULL;
+	tree->size = 0;
+	tree->chunks = 0;
+	tree->resizes = 0;
+
+	return tree;
+}
+
+static void freeChunks(Chunk * node){
+	if(node == NULL) return;
+
+	freeChunks(node->left);
+	freeChunks(node->right);
+	freeChunk(node);
+}
+
+void deleteChunkTree(ChunkTree * tree){
+	if(tree == NULL) return;
+
+	freeChunks(tree->root);
+	free(tree);
+}
+
+int chunkInsert(ChunkTree * tree, int position, struct entry * item){
+	int offset;
+	int index;
+
+	if(tree->root == NULL){
+		Chunk * first = newChunk();
+
+		if(first == NULL) return -1;
+
+		setRoot(tree, first);
+		tree->chunks = 1;
+		tree->resizes++;
+	}
+
+	Chunk * node = chunkLocate(tree->root, position, 1, &offset, &index);
+
+	// A full chunk hands its upper half to a new chunk placed right after it, except that
+	// appending past the last chunk just starts a new one so tail appends pack chunks full
+	if(node->count == CHUNK_SIZE && offset == CHUNK_SIZE && index == tree->chunks - 1){
+		Chunk * sibling = newChunk();
+
+		if(sibling == NULL) return -1;
+
+		chunkInsertAfter(tree, index, sibling);
+		node = sibling;
+		offset = 0;
+	}else if(node->count == CHUNK_SIZE){
+		Chunk * sibling = newChunk();
+		int half = CHUNK_SIZE / 2;
+
+		if(sibling == NULL) return -1;
+
+		memcpy(sibling->items->slots, node->items->slots + half, sizeof(struct entry *) * (CHUNK_SIZE - half));
+		sibling->count = CHUNK_SIZE - half;
+		node->count = half;
+		claimItems(sibling, 0);
+		chunkPull(sibling);
+		chunkFixUp(node);
+		chunkInsertAfter(tree, index, sibling);
+
+		if(offset > half){
+			node = sibling;
+			offset -= half;
+		}
+	}
+
+	if(chunkOwn(node) < 0) return -1;
+
+	memmove(node->items->slots + offset + 1, node->items->slots + offset, sizeof(struct entry *) * (node->count - offset));
+	node->items->slots[offset] = item;
+	item->where.chunk = node;
+	node->count++;
+	chunkFixUp(node);
+	tree->size++;
+
+	return 0;
+}
+
+struct entry * chunkRemove(ChunkTree * tree, int position){
+	int offset;
+	int index;
+	Chunk * node = chunkLocate(tree->root, position, 0, &offset, &index);
+
+	if(node == NULL || chunkOwn(node) < 0) return NULL;
+
+	struct entry * item = node->items->slots[offset];
+
+	memmove(node->items->slots + offset, node->items->slots + offset + 1, sizeof(struct entry *) * (node->count - offset - 1));
+	node->count--;
+	chunkFixUp(node);
+	tree->size--;
+
+	if(node->count == 0){
+		chunkRemoveAt(tree, index);
+		return item;
+	}
+
+	// Fold a sparse successor into this chunk so scans do not walk many near-empty chunks
+	Chunk * next = chunkNext(node);
+
+	if(node->count < CHUNK_SIZE / 4 && next != NULL && next->count < CHUNK_SIZE / 4 && chunkOwn(node) == 0){
+		memcpy(node->items->slots + node->count, next->items->slots, sizeof(struct entry *) * next->count);
+		node->count += next->count;
+		claimItems(node, node->count - next->count);
+		next->count = 0;
+		chunkFixUp(node);
+		chunkFixUp(next);
+		chunkRemoveAt(tree, index + 1);
+	}
+
+	return item;
+}
+
+struct entry * chunkGet(ChunkTree * tree, int position){
+	int offset;
+	int index;
+	Chunk * node = chunkLocate(tree->root, position, 0, &offset, &index);
+
+	return node == NULL ? NULL : node->items->slots[offset];
+}
+
+int chunkRank(Chunk * node, struct entry * item){
+	int rank = 0;
+
+	while(node->items->slots[rank] != item){
+		rank++;
+	}
+
+	rank += chunkTotal(node->left);
+
+	// Every ancestor reached from its right child precedes the whole subtree we came from
+	for(; node->parent != NULL; node = node->parent){
+		if(node == node->parent->right){
+			rank += chunkTotal(node->parent->left) + node->parent->count;
+		}
+	}
+
+	return rank;
+}
+
+Chunk * chunkFirst(ChunkTree * tree){
+	Chunk * node = tree->root;
+
+	while(node != NULL && node->left != NULL){
+		node = node->left;
+	}
+
+	return node;
+}
+
+Chunk * chunkNext(Chunk * node){
+	if(node->right != NULL){
+		node = node->right;
+
+		while(node->left != NULL){
+			node = node->left;
+		}
+
+		return node;
+	}
+
+	while(node->parent != NULL && node == node->parent->right){
+		node = node->parent;
+	}
+
+	return node->parent;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+// Entries per chunk. Chunks split in half when they overflow and are merged with their
+// successor once both have drained below a quarter of this.
+#define CHUNK_SIZE 64
+
+struct entry;
+
+/*
+    The entries of a chunk, kept apart from the tree node so snapshots can share them.
+    refs counts the chunk and every snapshot holding the array; while it is above one
+    the array is read-only, and an edit to the chunk first gives it a copy of its own.
+    refs is only touched through atomics, since snapshots release from their own threads.
+*/
+typedef struct chunkItems
+{
+	int refs;
+	struct entry * slots[CHUNK_SIZE];
+} ChunkItems;
+
+/*
+    A chunk of consecutive list entries that is also a node of an implicit treap.
+    Nodes are ordered by position and every node counts the entries and chunks in
+    its subtree, so a logical index is found by descending on those counts.
+*/
+typedef struct chunk
+{
+	ChunkItems * items;
+	int count;
+	int total;
+	int chunkCount;
+	unsigned priority;
+	struct chunk * left;
+	struct chunk * right;
+	struct chunk * parent;
+} Chunk;
+
+typedef struct chunkTree
+{
+	Chunk * root;
+	int size;
+	int chunks;
+	int resizes;
+} ChunkTree;
+
+ChunkTree * initializeChunkTree();
+
+/*
+    frees every chunk; the entries belong to the list's arena and are left alone
+*/
+void deleteChunkTree(ChunkTree *);
+
+/*
+    takes a reference to an items array, or drops one and frees the array with the last
+*/
+void chunkItemsRetain(ChunkItems *);
+void chunkItemsRelease(ChunkItems *);
+
+/*
+    positions are logical indices; callers validate the range. chunkInsert returns -1,
+    leaving the entry out of the tree, if it could not allocate the chunk it needed.
+*/
+int chunkInsert(ChunkTree *, int, struct entry *);
+struct entry * chunkRemove(ChunkTree *, int);
+struct entry * chunkGet(ChunkTree *, int);
+
+/*
+    returns the logical index of an entry held by the given chunk
+*/
+int chunkRank(Chunk *, struct entry *);
+
+/*
+    in-order walk over the chunks, returns NULL past the last chunk
+*/
+Chunk * chunkFirst(ChunkTree *);
+Chunk * chunkNext(Chunk *);
@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "entryArena.h"
+
+EntryArena * initializeArena(){
+	EntryArena * arena = (EntryArena *) malloc(sizeof(EntryArena));
+
+	if(arena == NULL){
+		printf("Unable to allocate memory for entry arena.\n");
+		return NULL;
+	}
+
+	arena->slabs = NULL;
+	arena->freeSlots = NULL;
+	arena->pool = NULL;
+	memset(arena->freeText, 0, sizeof(arena->freeText));
+	arena->liveEntries = 0;
+	arena->slabCount = 0;
+
+	return arena;
+}
+
+void deleteArena(EntryArena * arena){
+	if(arena == NULL) return;
+
+	while(arena->slabs != NULL){
+		ArenaSlab * next = arena->slabs->next;
+		free(arena->slabs);
+		arena->slabs = next;
+	}
+
+	while(arena->pool != NULL){
+		PoolBlock * next = arena->pool->next;
+		free(arena->pool);
+		arena->pool = next;
+	}
+
+	free(arena);
+}
+
+// Hands out a recycled slot if there is one, otherwise bumps the newest slab.
+static ArenaSlot * takeSlot(EntryArena * arena){
+	if(arena->freeSlots != NULL){
+		ArenaSlot * slot = arena->freeSlots;
+		arena->freeSlots = slot->nextFree;
+		return slot;
+	}
+
+	if(arena->slabs == NULL || arena->slabs->used == arena->slabs->capacity){
+		int capacity = (arena->slabs == NULL) ? ARENA_FIRST_SLAB : arena->slabs->capacity * 2;
+
+		if(capacity > ARENA_MAX_SLAB){
+			capacity = ARENA_MAX_SLAB;
+		}
+
+		ArenaSlab * slab = (ArenaSlab *) malloc(sizeof(ArenaSlab) + sizeof(ArenaSlot) * capacity);
+
+		if(slab == NULL) return NULL;
+
+		slab->next = arena->slabs;
+		slab->used = 0;
+		slab->capacity = capacity;
+		arena->slabs = slab;
+		arena->slabCount++;
+	}
+
+	return &arena->slabs->slots[arena->slabs->used++];
+}
+
+// The size class of pool text holding length bytes: class c holds ARENA_MIN_TEXT << c.
+static int textClass(int length){
+	int sizeClass = 0;
+
+	while((ARENA_MIN_TEXT << sizeClass) < length){
+		sizeClass++;
+	}
+
+	return sizeClass;
+}
+
+// Hands out freed text of the right size class if there is some, otherwise bump-allocates
+// it for names that do not fit in their slot. Freed text links through its first bytes.
+static char * poolAlloc(EntryArena * arena, int length){
+	int sizeClass = textClass(length);
+	int size = ARENA_MIN_TEXT << sizeClass;
+
+	if(arena->freeText[sizeClass] != NULL){
+		char * text = arena->freeText[sizeClass];
+		arena->freeText[sizeClass] = *(char **) text;
+		return text;
+	}
+
+	if(arena->pool == NULL || arena->pool->used + size > arena->pool->capacity){
+		int capacity = (size > ARENA_POOL_BLOCK) ? size : ARENA_POOL_BLOCK;
+		PoolBlock * block = (PoolBlock *) malloc(sizeof(PoolBlock) + capacity);
+
+		if(block == NULL) return NULL;
+
+		block->next = arena->pool;
+		block->used = 0;
+		block->capacity = capacity;
+		arena->pool = block;
+	}
+
+	char * text = arena->pool->text + arena->pool->used;
+	arena->pool->used += size;
+
+	return text;
+}
+
+Entry * arenaNewEntry(EntryArena * arena, char * name, char * lastname, float height, int age){
+	int nameLength = strlen(name) + 1;
+	int lastnameLength = strlen(lastname) + 1;
+	ArenaSlot * slot = takeSlot(arena);
+
+	if(slot == NULL) return NULL;
+
+	char * text = slot->text;
+
+	if(nameLength + lastnameLength > (int) ENTRY_INLINE_TEXT){
+		text = poolAlloc(arena, nameLength + lastnameLength);
+
+		if(text == NULL){
+			slot->nextFree = arena->freeSlots;
+			arena->freeSlots = slot;
+			return NULL;
+		}
+	}
+
+	memcpy(text, name, nameLength);
+	memcpy(text + nameLength, lastname, lastnameLength);
+
+	slot->entry.name = text;
+	slot->entry.lastname = text + nameLength;
+	slot->entry.height = height;
+	slot->entry.age = age;
+	arena->liveEntries++;
+
+	return &slot->entry;
+}
+
+void arenaFreeEntry(EntryArena * arena, Entry * entry){
+	if(entry == NULL) return;
+
+	// The entry is the first member of its slot, so the slot starts at the same address
+	ArenaSlot * slot = (ArenaSlot *) entry;
+
+	// Names kept outside the slot give their pool text back to its size class
+	if(entry->name != slot->text){
+		int sizeClass = textClass(strlen(entry->name) + strlen(entry->lastname) + 2);
+
+		*(char **) entry->name = arena->freeText[sizeClass];
+		arena->freeText[sizeClass] = entry->name;
+	}
+
+	slot->nextFree = arena->freeSlots;
+	arena->freeSlots = slot;
+	arena->liveEntries--;
+}
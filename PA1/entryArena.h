@@ -0,0 +1,73 @@
+#pragma once
+
+#include "list.h"
+
+// Each slot is one cache line: the Entry followed by room for both names and their terminators.
+#define ARENA_SLOT_SIZE 64
+#define ENTRY_INLINE_TEXT (ARENA_SLOT_SIZE - sizeof(Entry))
+
+// Slabs start small and double up to a limit, so a list of n entries holds O(log n) slabs.
+#define ARENA_FIRST_SLAB 64
+#define ARENA_MAX_SLAB 65536
+
+// Names too long for the slot are bump-allocated out of string pool blocks of this size.
+// Their text is rounded up to a power of two, from ARENA_MIN_TEXT bytes up, and a freed
+// entry's text goes onto the free list of its size class for the next name of that class.
+#define ARENA_POOL_BLOCK 65536
+#define ARENA_MIN_TEXT 32
+#define ARENA_TEXT_CLASSES 26
+
+typedef struct arenaSlot
+{
+	Entry entry;
+	union
+	{
+		char text[ENTRY_INLINE_TEXT];
+		struct arenaSlot* nextFree;
+	};
+} ArenaSlot;
+
+typedef struct arenaSlab
+{
+	struct arenaSlab* next;
+	int used;
+	int capacity;
+	ArenaSlot slots[];
+} ArenaSlab;
+
+typedef struct poolBlock
+{
+	struct poolBlock* next;
+	int used;
+	int capacity;
+	char text[];
+} PoolBlock;
+
+/*
+    Owns every Entry of one list. Freed slots and pool text go onto free lists and are
+    handed out again before the current slab or pool block is bumped; the whole arena is
+    released slab by slab and block by block.
+*/
+typedef struct entryArena
+{
+	ArenaSlab* slabs;
+	ArenaSlot* freeSlots;
+	PoolBlock* pool;
+	char* freeText[ARENA_TEXT_CLASSES];
+	int liveEntries;
+	int slabCount;
+} EntryArena;
+
+EntryArena* initializeArena();
+
+/*
+    frees every slab and pool block, and with them every entry still allocated
+*/
+void deleteArena(EntryArena* arena);
+
+/*
+    returns NULL if memory for a new slab or pool block cannot be allocated
+*/
+Entry* arenaNewEntry(EntryArena* arena, char* name, char* lastname, float height, int age);
+
+void arenaFreeEntry(EntryArena* arena, Entry* entry);
@@ -0,0 +1,857 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "list.h"
+#include "entryArena.h"
+#include "nameIndex.h"
+#include "nameKeys.h"
+#include "snapshot.h"
+
+// FUNCTION DEFINTIONS
+/* The function declarations have been given to you which should make the parameters and the return value for each function obvious.
+The printList and printListInfo functions have been coded to start you off.*/
+
+// Allocates an Entry for the list out of its arena and adds it to the name index.
+Entry * listNewEntry(List * myList, char * name, char * lastname, float height, int age){
+	Entry * entry = arenaNewEntry(myList->arena, name, lastname, height, age);
+
+	if(entry == NULL){
+		printf("Unable to allocate memory for entry.\n");
+		return NULL;
+	}
+
+	if(myList->index != NULL && nameIndexAdd(myList->index, entry) < 0){
+		arenaFreeEntry(myList->arena, entry);
+		return NULL;
+	}
+
+	return entry;
+}
+
+// Drops an Entry that has been taken out of the list from the name index and the arena.
+// chunkRemove hands back NULL when it could not take the entry out, and that is ignored.
+void listReleaseEntry(List * myList, Entry * entry){
+	if(entry == NULL) return;
+
+	if(myList->index != NULL){
+		nameIndexRemove(myList->index, entry);
+	}
+
+	// A snapshot may still be reading the entry, so its slot must not be reused yet
+	if(__atomic_load_n(&myList->snapshots, __ATOMIC_ACQUIRE) > 0){
+		entry->where.nextParked = myList->parked;
+		myList->parked = entry;
+		return;
+	}
+
+	arenaFreeEntry(myList->arena, entry);
+	listFreeParked(myList);
+}
+
+void listFreeParked(List * myList){
+	if(myList->parked == NULL || __atomic_load_n(&myList->snapshots, __ATOMIC_ACQUIRE) > 0){
+		return;
+	}
+
+	while(myList->parked != NULL){
+		Entry * entry = myList->parked;
+
+		myList->parked = entry->where.nextParked;
+		arenaFreeEntry(myList->arena, entry);
+	}
+}
+
+// The block holding a ring's name keys for cap slots, followed by their lengths.
+static uint64_t * newKeys(int cap){
+	return (uint64_t *) malloc((sizeof(uint64_t) + sizeof(int)) * (size_t) cap);
+}
+
+static void bindKeys(List * myList, uint64_t * keys, int cap){
+	myList->keys = keys;
+	myList->keyLengths = (keys != NULL) ? (int *) (keys + cap) : NULL;
+}
+
+// Stores an entry in a ring slot and lets the entry know where it now lives.
+static void ringPlace(List * myList, int slot, Entry * entry){
+	myList->data[slot] = entry;
+	entry->where.slot = slot;
+
+	if(myList->keys != NULL){
+		myList->keys[slot] = nameKey(entry->name, &myList->keyLengths[slot]);
+	}
+}
+
+// Moves count entries from logical index from to logical index to, one position up or down,
+// with a memmove per run that is contiguous in the block both where it is read and written.
+// The ring wraps at most once, so that is at most three runs.
+static void ringShift(List * myList, int to, int from, int count){
+	int cap = myList->capacity;
+
+	while(count > 0){
+		// Moving down reads ahead of the writes, so it goes front to back; moving up, back to front
+		int source = (to < from) ? listSlot(myList, from) : listSlot(myList, from + count - 1);
+		int target = (to < from) ? listSlot(myList, to) : listSlot(myList, to + count - 1);
+		int run = count;
+
+		if(to < from){
+			if(run > cap - source) run = cap - source;
+			if(run > cap - target) run = cap - target;
+		}else{
+			if(run > source + 1) run = source + 1;
+			if(run > target + 1) run = target + 1;
+			source -= run - 1;
+			target -= run - 1;
+		}
+
+		memmove(myList->data + target, myList->data + source, sizeof(Entry *) * run);
+
+		if(myList->keys != NULL){
+			memmove(myList->keys + target, myList->keys + source, sizeof(uint64_t) * run);
+			memmove(myList->keyLengths + target, myList->keyLengths + source, sizeof(int) * run);
+		}
+
+		if(to < from){
+			from += run;
+			to += run;
+		}
+
+		count -= run;
+	}
+}
+
+/*
+    Keeps the stale range in step with an entry inserted (delta 1) or deleted (delta -1) at
+    position, which moves the logical index of every entry after it, then adds [from, to):
+    the logical indices the entries shifted to make or close the gap have now.
+*/
+static void ringStale(List * myList, int position, int delta, int from, int to){
+	int low = myList->staleFrom;
+	int high = myList->staleTo;
+
+	if(low < high){
+		if(low > position || (delta > 0 && low == position)) low += delta;
+		if(high > position) high += delta;
+	}
+
+	if(from < to){
+		low = (low < high && low < from) ? low : from;
+		high = (high > to) ? high : to;
+	}
+
+	myList->staleFrom = (low < high) ? low : 0;
+	myList->staleTo = (low < high) ? high : 0;
+}
+
+void listAdoptRing(List * myList, Entry ** block, int size, int cap){
+	free(myList->data);
+	myList->data = block;
+	myList->capacity = cap;
+
+	// Without room for the keys findPosition falls back to comparing every name
+	if(myList->keys != NULL){
+		free(myList->keys);
+		bindKeys(myList, newKeys(cap), cap);
+	}
+
+	for(int i = 0; i < size; i++){
+		ringPlace(myList, i, block[i]);
+	}
+
+	myList->head = 0;
+	myList->size = size;
+	myList->staleFrom = 0;
+	myList->staleTo = 0;
+}
+
+void listDropIndex(List * myList){
+	deleteNameIndex(myList->index);
+	myList->index = NULL;
+
+	if(myList->backend != LIST_RING || myList->keys != NULL){
+		return;
+	}
+
+	// Without room for the keys findPosition falls back to comparing every name
+	bindKeys(myList, newKeys(myList->capacity), myList->capacity);
+
+	for(int i = 0; i < myList->size && myList->keys != NULL; i++){
+		int slot = listSlot(myList, i);
+
+		myList->keys[slot] = nameKey(myList->data[slot]->name, &myList->keyLengths[slot]);
+	}
+}
+
+List * initializeList(int backend){
+	List * newList = (List *) malloc(sizeof(List));
+	
+	if(newList == NULL){
+		printf("Unable to allocate memory for list.\n");
+		return NULL;
+	}
+
+	newList->size = 0;
+	newList->head = 0;
+	newList->staleFrom = 0;
+	newList->staleTo = 0;
+	newList->growthFactor = DEFAULT_GROWTH_FACTOR;
+	newList->reserved = 0;
+	newList->reallocs = 0;
+	newList->backend = backend;
+	newList->sortKey = SORT_NONE;
+	newList->snapshots = 0;
+	newList->parked = NULL;
+	newList->jobs = NULL;
+	newList->chunks = NULL;
+	newList->keys = NULL;
+	newList->keyLengths = NULL;
+	newList->arena = initializeArena();
+	newList->index = initializeNameIndex();
+
+	if(newList->arena == NULL || newList->index == NULL){
+		deleteArena(newList->arena);
+		deleteNameIndex(newList->index);
+		free(newList);
+		return NULL;
+	}
+
+	if(backend == LIST_CHUNKED){
+		newList->capacity = 0;
+		newList->data = NULL;
+		newList->chunks = initializeChunkTree();
+
+		if(newList->chunks == NULL){
+			deleteArena(newList->arena);
+			deleteNameIndex(newList->index);
+			free(newList);
+			return NULL;
+		}
+
+		return newList;
+	}
+
+	newList->data = (Entry **) malloc(sizeof(Entry *) * INITIAL_CAPACITY);
+	
+	if(newList->data == NULL){
+		printf("Unable to allocate memory for entries.\n");
+		deleteArena(newList->arena);
+		deleteNameIndex(newList->index);
+		free(newList);
+		return NULL;
+	}
+
+	newList->capacity = INITIAL_CAPACITY;
+
+	return newList;
+}
+
+// Maps a logical index onto its slot in the ring buffer.
+int listSlot(List * myList, int i){
+	int slot = myList->head + i;
+
+	if(slot >= myList->capacity){
+		slot -= myList->capacity;
+	}
+
+	return slot;
+}
+
+Entry * listGet(List * myList, int i){
+	if(myList->backend == LIST_CHUNKED){
+		return chunkGet(myList->chunks, i);
+	}
+
+	return myList->data[listSlot(myList, i)];
+}
+
+int listRank(List * myList, Entry * entry){
+	if(myList->backend == LIST_CHUNKED){
+		return chunkRank(entry->where.chunk, entry);
+	}
+
+	// The recorded slot is right if it still holds the entry; live slots hold distinct entries
+	int slot = entry->where.slot;
+	int rank = (slot - myList->head + myList->capacity) % myList->capacity;
+
+	if(slot < myList->capacity && rank < myList->size && myList->data[slot] == entry){
+		return rank;
+	}
+
+	for(int i = myList->staleFrom; i < myList->staleTo; i++){
+		slot = listSlot(myList, i);
+		myList->data[slot]->where.slot = slot;
+	}
+
+	myList->staleFrom = 0;
+	myList->staleTo = 0;
+
+	return (entry->where.slot - myList->head + myList->capacity) % myList->capacity;
+}
+
+void listIterBegin(List * myList, ListIter * iter){
+	iter->list = myList;
+	iter->index = 0;
+	iter->offset = 0;
+	iter->chunk = (myList->backend == LIST_CHUNKED) ? chunkFirst(myList->chunks) : NULL;
+}
+
+Entry * listIterNext(ListIter * iter){
+	if(iter->index >= iter->list->size){
+		return NULL;
+	}
+
+	iter->index++;
+
+	if(iter->list->backend != LIST_CHUNKED){
+		return iter->list->data[listSlot(iter->list, iter->index - 1)];
+	}
+
+	while(iter->offset == iter->chunk->count){
+		iter->chunk = chunkNext(iter->chunk);
+		iter->offset = 0;
+	}
+
+	return iter->chunk->items->slots[iter->offset++];
+}
+
+// Mirrors the chunk tree's counts into the fields printListInfo reports.
+static void syncChunkInfo(List * myList){
+	myList->size = myList->chunks->size;
+	myList->capacity = myList->chunks->chunks * CHUNK_SIZE;
+	myList->reallocs = myList->chunks->resizes;
+}
+
+void deleteList(List * myList){
+	if(myList == NULL){
+		printf("No list to delete!\n");
+		return;
+	}
+
+	waitSnapshots(myList);
+
+	// Every entry lives in the arena, so the whole list goes a slab at a time
+	// rather than one entry at a time
+	deleteArena(myList->arena);
+	deleteNameIndex(myList->index);
+	deleteChunkTree(myList->chunks);
+	free(myList->data);
+	free(myList->keys);
+
+	free(myList);
+}
+
+int clearList(List * myList){
+	if(myList == NULL){
+		printf("No list to clear!\n");
+		return -1;
+	}
+
+	// The entries are about to go with the old arena, so every export has to finish first
+	waitSnapshots(myList);
+
+	EntryArena * arena = initializeArena();
+	NameIndex * index = (myList->index != NULL) ? initializeNameIndex() : NULL;
+	ChunkTree * chunks = (myList->backend == LIST_CHUNKED) ? initializeChunkTree() : NULL;
+
+	if(arena == NULL || (myList->index != NULL && index == NULL) || (myList->backend == LIST_CHUNKED && chunks == NULL)){
+		deleteArena(arena);
+		deleteNameIndex(index);
+		deleteChunkTree(chunks);
+		return -1;
+	}
+
+	deleteArena(myList->arena);
+	deleteNameIndex(myList->index);
+	myList->arena = arena;
+	myList->index = index;
+	myList->size = 0;
+	myList->head = 0;
+	myList->staleFrom = 0;
+	myList->staleTo = 0;
+
+	if(myList->backend == LIST_CHUNKED){
+		chunks->resizes = myList->chunks->resizes;
+		deleteChunkTree(myList->chunks);
+		myList->chunks = chunks;
+		syncChunkInfo(myList);
+	}
+
+	return 0;
+}
+
+int setCapacity(List * myList, int cap){
+	if(myList == NULL || myList->data == NULL){
+		printf("No list to set capacity on!\n");
+		return -1;
+	}
+
+	if(cap <= 0){
+		printf("Capacity must be greater than 0.\n");
+		return -2;
+	}
+
+	if(cap < myList->size){
+		printf("Capacity cannot be less than the size of the list.\n");
+		return -2;
+	}
+
+	// The ring may wrap around the end of the block, so unwrap it into the new block
+	// rather than letting realloc copy the slots in their physical order.
+	Entry ** newBlock = (Entry **) malloc(sizeof(Entry *) * cap);
+	uint64_t * keys = (myList->keys != NULL) ? newKeys(cap) : NULL;
+
+    if (newBlock == NULL || (myList->keys != NULL && keys == NULL)) {
+        printf("Failed to set capacity. Memory reallocation failed.\n");
+        free(newBlock);
+        free(keys);
+        return -3;
+    }
+
+	// The ring occupies at most two runs of slots: from head to the end of the block,
+	// then from the start of the block
+	int first = (myList->capacity - myList->head < myList->size) ? myList->capacity - myList->head : myList->size;
+
+	memcpy(newBlock, myList->data + myList->head, sizeof(Entry *) * first);
+	memcpy(newBlock + first, myList->data, sizeof(Entry *) * (myList->size - first));
+
+	if(keys != NULL){
+		int * keyLengths = (int *) (keys + cap);
+
+		memcpy(keys, myList->keys + myList->head, sizeof(uint64_t) * first);
+		memcpy(keys + first, myList->keys, sizeof(uint64_t) * (myList->size - first));
+		memcpy(keyLengths, myList->keyLengths + myList->head, sizeof(int) * first);
+		memcpy(keyLengths + first, myList->keyLengths, sizeof(int) * (myList->size - first));
+		free(myList->keys);
+		bindKeys(myList, keys, cap);
+	}
+
+	free(myList->data);
+	myList->data = newBlock;
+	myList->capacity = cap;
+	myList->head = 0;
+	myList->staleFrom = 0;
+	myList->staleTo = myList->size;
+	myList->reallocs++;
+
+	return 0;
+}
+
+int setGrowthFactor(List * myList, float factor){
+	if(!(factor > 1.0f)){
+		printf("Growth factor must be greater than 1.\n");
+		return -1;
+	}
+
+	myList->growthFactor = factor;
+
+	return 0;
+}
+
+int growTarget(List * myList, int cap){
+	int next = (int) (cap * myList->growthFactor);
+
+	// Small factors can round back down to the current capacity
+	return (next <= cap) ? cap + 1 : next;
+}
+
+int shrinkTarget(List * myList, int size, int cap){
+	if(size >= cap / SHRINK_THRESHOLD){
+		return cap;
+	}
+
+	return (cap / 2 < myList->reserved) ? myList->reserved : cap / 2;
+}
+
+void growCapacity(List * myList){
+	if(setCapacity(myList, growTarget(myList, myList->capacity)) < 0){
+		printf("Unable to grow capacity of list!\n");
+		return;
+	}
+}
+
+void halveCapacity(List * myList){
+	int cap = (myList->capacity / 2 < myList->reserved) ? myList->reserved : myList->capacity / 2;
+
+	if(cap == myList->capacity){
+		return;
+	}
+
+	if(setCapacity(myList, cap) < 0){
+		printf("Unable to halve capacity of list!\n");
+		return;
+	}
+}
+
+// Halves the ring once it has drained below the shrink threshold.
+static void shrinkIfSparse(List * myList){
+	if(shrinkTarget(myList, myList->size, myList->capacity) != myList->capacity){
+		halveCapacity(myList);
+	}
+}
+
+void reserve(List * myList, int n){
+	if(myList == NULL){
+		printf("No list to reserve capacity on!\n");
+		return;
+	}
+
+	if(n < 0){
+		printf("Cannot reserve a negative capacity.\n");
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		return;
+	}
+
+	myList->reserved = n;
+
+	if(n > myList->capacity){
+		setCapacity(myList, n);
+	}
+}
+
+void shrinkToFit(List * myList){
+	if(myList == NULL){
+		printf("No list to shrink!\n");
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		return;
+	}
+
+	int cap = (myList->size > 0) ? myList->size : 1;
+
+	myList->reserved = 0;
+
+	if(cap != myList->capacity){
+		setCapacity(myList, cap);
+	}
+}
+
+// Stores a new entry in the chunk tree, or drops it from the index and the arena again
+// if the tree had no room for it; chunkInsert has already reported why.
+static void chunkPlace(List * myList, int position, Entry * entry){
+	if(chunkInsert(myList->chunks, position, entry) < 0){
+		listReleaseEntry(myList, entry);
+	}
+
+	syncChunkInfo(myList);
+}
+
+void insertToTail(List* myList, char* name, char* lastname, float height, int age){
+	if(myList == NULL){
+		printf("No list to insert onto tail.\n");
+		return;
+	}
+
+	Entry * entry = listNewEntry(myList, name, lastname, height, age);
+
+	if(entry == NULL){
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		chunkPlace(myList, myList->size, entry);
+		return;
+	}
+
+	if(myList->size == myList->capacity){
+		growCapacity(myList);
+	}
+
+	ringPlace(myList, listSlot(myList, myList->size), entry);
+	myList->size++;
+}
+
+void insertToHead(List* myList, char* name, char* lastname, float height, int age){
+	if(myList == NULL){
+		printf("No list to insert before head.\n");
+		return;
+	}
+
+	Entry * entry = listNewEntry(myList, name, lastname, height, age);
+
+	if(entry == NULL){
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		chunkPlace(myList, 0, entry);
+		return;
+	}
+
+	if(myList->size == myList->capacity){
+		growCapacity(myList);
+	}
+
+	// Step the head back one slot instead of shifting every entry forward
+	myList->head = (myList->head == 0) ? myList->capacity - 1 : myList->head - 1;
+	ringPlace(myList, myList->head, entry);
+	myList->size++;
+	ringStale(myList, 0, 1, 0, 0);
+}
+
+void deleteFromTail(List* myList){
+	if(myList == NULL){
+		printf("No list to delete from.\n");
+		return;
+	}
+
+	if(myList->size == 0){
+		printf("No tail to delete from!\n");
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		listReleaseEntry(myList, chunkRemove(myList->chunks, myList->size - 1));
+		syncChunkInfo(myList);
+		return;
+	}
+
+	int slot = listSlot(myList, myList->size - 1);
+
+	listReleaseEntry(myList, myList->data[slot]);
+	myList->data[slot] = NULL;
+	myList->size--;
+	ringStale(myList, myList->size, -1, 0, 0);
+
+	shrinkIfSparse(myList);
+}
+
+void deleteFromHead(List * myList){
+	if(myList == NULL){
+		printf("No list to delete from.\n");
+		return;
+	}
+
+	if(myList->size == 0){
+		printf("No head to delete from!\n");
+		return;
+	}
+
+	if(myList->backend == LIST_CHUNKED){
+		listReleaseEntry(myList, chunkRemove(myList->chunks, 0));
+		syncChunkInfo(myList);
+		return;
+	}
+
+	listReleaseEntry(myList, myList->data[myList->head]);
+	myList->data[myList->head] = NULL;
+
+	// Step the head forward one slot instead of shifting every entry back
+	myList->head = listSlot(myList, 1);
+	myList->size--;
+	ringStale(myList, 0, -1, 0, 0);
+
+	if(myList->size == 0){
+		myList->head = 0;
+	}
+
+	shrinkIfSparse(myList);
+}
+
+// Returns the first slot in [from, to) holding name, or -1. Only slots whose key and length
+// both match are compared in full, and a name that fits in its key needs no comparison at all.
+static int scanRun(List * myList, int from, int to, char * name, uint64_t key, int length){
+	for(int i = nameKeyScan(myList->keys, from, to, key); i < to; i = nameKeyScan(myList->keys, i + 1, to, key)){
+		if(myList->keyLengths[i] == length && (length <= NAME_KEY_BYTES || strcmp(name, myList->data[i]->name) == 0)){
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// findPosition for a list without a name index: a front-to-back scan.
+static int scanPosition(List * myList, char * name){
+	if(myList->keys == NULL){
+		ListIter iter;
+		Entry * entry;
+
+		listIterBegin(myList, &iter);
+
+		while((entry = listIterNext(&iter)) != NULL){
+			if(strcmp(name, entry->name) == 0) return iter.index - 1;
+		}
+
+		return -1;
+	}
+
+	int length;
+	uint64_t key = nameKey(name, &length);
+
+	// The ring occupies at most two runs of slots: from head to the end of the block,
+	// then from the start of the block
+	int first = (myList->capacity - myList->head < myList->size) ? myList->capacity - myList->head : myList->size;
+	int slot = scanRun(myList, myList->head, myList->head + first, name, key, length);
+
+	if(slot >= 0) return slot - myList->head;
+
+	slot = scanRun(myList, 0, myList->size - first, name, key, length);
+
+	return (slot >= 0) ? slot + first : -1;
+}
+
+int findPosition(List* myList, char* name){
+	if(myList == NULL){
+		printf("No list to search!\n");
+		return -1;
+	}
+
+	if(myList->index == NULL){
+		return scanPosition(myList, name);
+	}
+
+	return nameIndexPosition(myList->index, myList, name);
+}
+
+void insertToPosition(List* myList, int position, char* name, char* lastname, float height, int age) {
+    if(myList == NULL) {
+        printf("No list to insert into.\n");
+        return;
+    }
+
+    if(position < 0 || position > myList->size) {
+        printf("Cannot insert at position: %d. Invalid position.\n", position);
+        return;
+    }
+
+    Entry * entry = listNewEntry(myList, name, lastname, height, age);
+
+    if(entry == NULL) {
+        return;
+    }
+
+    if(myList->backend == LIST_CHUNKED) {
+        chunkPlace(myList, position, entry);
+        return;
+    }
+
+    if(myList->size == myList->capacity) {
+        growCapacity(myList);
+    }
+
+    // Open the gap on whichever side of the position has fewer entries to move
+    if(position < myList->size - position) {
+        myList->head = (myList->head == 0) ? myList->capacity - 1 : myList->head - 1;
+
+        ringShift(myList, 0, 1, position);
+        ringStale(myList, position, 1, 0, position);
+    } else {
+        ringShift(myList, position + 1, position, myList->size - position);
+        ringStale(myList, position, 1, position + 1, myList->size + 1);
+    }
+
+    ringPlace(myList, listSlot(myList, position), entry);
+    myList->size++;
+}
+
+
+void deleteFromPosition(List* myList, int position) {
+    if(myList == NULL) {
+        printf("No list to delete from.\n");
+        return;
+    }
+
+    if(myList->size == 0) {
+        printf("No entries in the list to delete.\n");
+        return;
+    }
+
+    if(position < 0 || position >= myList->size) {
+        printf("Deletion position out of bounds.\n");
+        return;
+    }
+
+    if(myList->backend == LIST_CHUNKED) {
+        listReleaseEntry(myList, chunkRemove(myList->chunks, position));
+        syncChunkInfo(myList);
+        return;
+    }
+
+    listReleaseEntry(myList, listGet(myList, position));
+
+    // Close the gap from whichever side of the position has fewer entries to move
+    if(position < myList->size - 1 - position) {
+        ringShift(myList, 1, 0, position);
+        ringStale(myList, position, -1, 0, position);
+
+        myList->data[myList->head] = NULL;
+        myList->head = listSlot(myList, 1);
+    } else {
+        ringShift(myList, position, position + 1, myList->size - 1 - position);
+        ringStale(myList, position, -1, position, myList->size - 1);
+
+        myList->data[listSlot(myList, myList->size - 1)] = NULL;
+    }
+
+    myList->size--;
+
+    if(myList->size == 0) {
+        myList->head = 0;
+    }
+
+    shrinkIfSparse(myList);
+}
+
+void outEntry(OutBuffer* out, int index, Entry* entry)
+{
+	outChar(out, '[');
+	outInt(out, index);
+	outText(out, "]\t");
+	outText(out, entry->name);
+	outChar(out, '\t');
+	outText(out, entry->lastname);
+	outChar(out, '\t');
+	outFixed2(out, entry->height);
+	outChar(out, '\t');
+	outInt(out, entry->age);
+	outChar(out, '\n');
+}
+
+// Given a pointer to a List struct, this function prints each Entry in that list.
+// The entries are formatted into an OutBuffer rather than through printf, which keeps
+// long lists from being bound by stdio locking and float conversion.
+void printList(List* myList)
+{
+	if (myList == NULL)
+	{
+		printf("No list to print!\n");
+	}
+	else if (myList->size == 0)
+	{
+		printf("List is empty!\n");
+	}
+	else
+	{
+		static OutBuffer out;
+		ListIter iter;
+		Entry* entry;
+
+		// Anything printf still holds has to reach the descriptor first
+		fflush(stdout);
+		outInit(&out, STDOUT_FILENO);
+		listIterBegin(myList, &iter);
+
+		while ((entry = listIterNext(&iter)) != NULL)
+		{
+			outEntry(&out, iter.index - 1, entry);
+		}
+
+		outFlush(&out);
+	}
+}
+
+// Given a pointer to a List struct, this function prints out the size and capacity of that List, and how often its storage was resized.
+void printListInfo(List* myList)
+{
+	if (myList == NULL)
+	{
+		printf("No list to print!\n");
+		return;
+	}
+
+	printf("size:%d, capacity:%d, reallocs:%d\n", myList->size, myList->capacity, myList->reallocs);
+}
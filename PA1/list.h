@@ -0,0 +1,201 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "chunkList.h"
+#include "outBuffer.h"
+
+struct entryArena;
+struct nameIndex;
+struct snapshotJob;
+
+// CONSTANT DECLARATIONS
+#define INITIAL_CAPACITY 2
+
+// CAPACITY POLICY
+// A full ring grows by the list's growth factor, but it only halves once fewer than
+// 1/SHRINK_THRESHOLD of its slots are in use. The gap between the two keeps a run of
+// alternating inserts and deletes at the boundary from reallocating on every command.
+#define DEFAULT_GROWTH_FACTOR 2.0f
+#define SHRINK_THRESHOLD 4
+
+// Storage layouts a List can be created with
+#define LIST_RING 0
+#define LIST_CHUNKED 1
+
+// Orders a sorted view of a list can follow (see sortView.h)
+#define SORT_NONE 0
+#define SORT_AGE 1
+#define SORT_HEIGHT 2
+#define SORT_NAME 3
+
+// STRUCT DECLARATIONS
+// member is the entry's place among the entries of its name in the list's name index. The entry
+// also records where it is stored (its ring slot or its chunk) so its logical index can be
+// recovered without a scan; once the list has parked it, where links the parked chain instead.
+typedef struct entry
+{
+	char* name;
+	char* lastname;
+	float height;
+	int age;
+	int member;
+	union
+	{
+		int slot;
+		struct chunk* chunk;
+		struct entry* nextParked;
+	} where;
+} Entry;
+
+// With the ring layout the entries live in a ring buffer: logical index i is stored at data[(head + i) % capacity],
+// so both ends of the list can grow and shrink without shifting the rest of the entries.
+// With the chunked layout data is unused and the entries live in fixed-size chunks of a counted tree,
+// which makes positional edits O(log n); capacity then reports the slots held by those chunks.
+// Either way the entries themselves are allocated from the list's arena and indexed by name,
+// unless the index was dropped, in which case index is NULL and name lookups scan the list.
+// A ring without a name index keeps every slot's name key and name length (see nameKeys.h)
+// in keys and keyLengths, which share one allocation of their own, for findPosition to scan;
+// with the index on both are NULL and nothing but data moves with the entries.
+// Shifting ring entries does not update their where.slot: the entries at logical indices
+// [staleFrom, staleTo) may have moved since, and listRank refreshes them when it meets one.
+// reserved is a floor the ring will not shrink below, and reallocs counts how often the
+// storage was resized (ring reallocations, or chunks allocated and freed).
+// sortKey is the order printSorted lists the entries in.
+// snapshots counts the live snapshots (see snapshot.h), which the list must not free entries
+// out from under: entries dropped meanwhile are parked on a chain through where.nextParked,
+// and jobs are running exports.
+typedef struct list
+{
+	int capacity;
+	int size;
+	int head;
+	int staleFrom;
+	int staleTo;
+	Entry** data;
+	uint64_t* keys;
+	int* keyLengths;
+	float growthFactor;
+	int reserved;
+	int reallocs;
+	int backend;
+	int sortKey;
+	int snapshots;
+	Entry* parked;
+	struct snapshotJob* jobs;
+	ChunkTree* chunks;
+	struct entryArena* arena;
+	struct nameIndex* index;
+} List;
+
+// Walks a list in logical order without paying for a positional lookup per entry.
+typedef struct listIter
+{
+	List* list;
+	int index;
+	Chunk* chunk;
+	int offset;
+} ListIter;
+
+/*
+    backend is LIST_RING or LIST_CHUNKED
+*/
+List* initializeList(int backend);
+
+int listSlot(List* myList, int i);
+
+Entry* listGet(List* myList, int i);
+
+/*
+    returns the logical index of an entry that is in the list
+*/
+int listRank(List* myList, Entry* entry);
+
+/*
+    allocate an entry from the list's arena and add it to the name index, or drop an entry
+    that is no longer stored in the list from both; listNewEntry returns NULL on failure
+*/
+Entry* listNewEntry(List* myList, char* name, char* lastname, float height, int age);
+void listReleaseEntry(List* myList, Entry* entry);
+
+/*
+    frees the entries parked while snapshots were live, once none is
+*/
+void listFreeParked(List* myList);
+
+/*
+    frees the name index so the list stops maintaining it; findPosition then scans,
+    through name keys a ring starts keeping here
+*/
+void listDropIndex(List* myList);
+
+/*
+    makes block, an array of cap entries whose first size slots already hold the list's
+    entries in order, the list's ring, and frees the old one
+*/
+void listAdoptRing(List* myList, Entry** block, int size, int cap);
+
+void listIterBegin(List* myList, ListIter* iter);
+
+/*
+    returns NULL once every entry has been visited
+*/
+Entry* listIterNext(ListIter* iter);
+
+int setCapacity(List * myList, int cap);
+void deleteList(List* myList);
+
+/*
+    removes every entry but keeps the list, its layout and its capacity;
+    returns -1 if the list could not be reset
+*/
+int clearList(List* myList);
+
+/*
+    returns -1 unless factor is greater than 1
+*/
+int setGrowthFactor(List* myList, float factor);
+
+/*
+    the capacity policy on its own: growTarget is the capacity a full ring of capacity cap
+    grows to, and shrinkTarget the capacity a ring of capacity cap moves to once it holds
+    size entries (cap itself while it is not sparse enough to shrink)
+*/
+int growTarget(List* myList, int cap);
+int shrinkTarget(List* myList, int size, int cap);
+
+void growCapacity(List* myList);
+
+void halveCapacity(List* myList);
+
+/*
+    reserve makes room for at least n entries and keeps the ring from shrinking below n;
+    shrinkToFit drops that floor and trims the ring to its size. Chunked lists size their
+    storage chunk by chunk, so both leave them unchanged.
+*/
+void reserve(List* myList, int n);
+
+void shrinkToFit(List* myList);
+
+void insertToHead(List* myList, char* name, char* lastname, float height, int age);
+
+void insertToTail(List* myList, char* name, char* lastname, float height, int age);
+
+void insertToPosition(List* myList, int position, char* name, char* lastname, float height, int age);
+
+int findPosition(List* myList, char* name);
+
+void deleteFromHead(List* myList);
+
+void deleteFromTail(List* myList);
+
+void deleteFromPosition(List* myList, int position);
+
+/*
+    writes one printList line: the index, both names, the height and the age
+*/
+void outEntry(OutBuffer* out, int index, Entry* entry);
+
+void printList(List* myList);
+
+void printListInfo(List* myList);
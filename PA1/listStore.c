@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "listStore.h"
+
+int saveList(List * myList, char * path){
+	if(myList == NULL){
+		printf("No list to save!\n");
+		return -1;
+	}
+
+	ListIter iter;
+	Entry * entry;
+	uint64_t blobSize = 0;
+
+	listIterBegin(myList, &iter);
+
+	while((entry = listIterNext(&iter)) != NULL){
+		blobSize += strlen(entry->name) + strlen(entry->lastname) + 2;
+	}
+
+	if(blobSize > UINT32_MAX){
+		printf("List is too large to save.\n");
+		return -1;
+	}
+
+	FILE * fp = fopen(path, "wb");
+
+	if(fp == NULL){
+		printf("Unable to open %s for saving.\n", path);
+		return -1;
+	}
+
+	ListFileHeader header = { LIST_FILE_MAGIC, LIST_FILE_VERSION, myList->size, (uint32_t) blobSize };
+	uint32_t offset = 0;
+
+	fwrite(&header, sizeof(header), 1, fp);
+
+	// The record table first, then the blob its offsets point into
+	listIterBegin(myList, &iter);
+
+	while((entry = listIterNext(&iter)) != NULL){
+		ListFileRecord record;
+
+		record.height = entry->height;
+		record.age = entry->age;
+		record.name = offset;
+		offset += strlen(entry->name) + 1;
+		record.lastname = offset;
+		offset += strlen(entry->lastname) + 1;
+
+		fwrite(&record, sizeof(record), 1, fp);
+	}
+
+	listIterBegin(myList, &iter);
+
+	while((entry = listIterNext(&iter)) != NULL){
+		fwrite(entry->name, strlen(entry->name) + 1, 1, fp);
+		fwrite(entry->lastname, strlen(entry->lastname) + 1, 1, fp);
+	}
+
+	if(ferror(fp) || fclose(fp) != 0){
+		printf("Unable to write %s.\n", path);
+		return -1;
+	}
+
+	return 0;
+}
+
+// Checks that the header describes exactly this file and that every name offset
+// lands on a NUL-terminated string inside the blob.
+static int validListFile(char * file, size_t size){
+	if(size < sizeof(ListFileHeader)) return 0;
+
+	ListFileHeader * header = (ListFileHeader *) file;
+
+	if(header->magic != LIST_FILE_MAGIC || header->version != LIST_FILE_VERSION) return 0;
+
+	if(size != sizeof(ListFileHeader) + (size_t) header->count * sizeof(ListFileRecord) + header->blobSize) return 0;
+
+	if(header->count > 0 && (header->blobSize == 0 || file[size - 1] != '\0')) return 0;
+
+	ListFileRecord * records = (ListFileRecord *) (file + sizeof(ListFileHeader));
+
+	for(uint32_t i = 0; i < header->count; i++){
+		if(records[i].name >= header->blobSize || records[i].lastname >= header->blobSize) return 0;
+	}
+
+	return 1;
+}
+
+int loadList(List * myList, char * path){
+	if(myList == NULL){
+		printf("No list to load into!\n");
+		return -1;
+	}
+
+	int fd = open(path, O_RDONLY);
+	struct stat info;
+
+	if(fd < 0 || fstat(fd, &info) < 0){
+		printf("Unable to open %s for loading.\n", path);
+
+		if(fd >= 0) close(fd);
+
+		return -1;
+	}
+
+	size_t size = info.st_size;
+	char * file = (size > 0) ? (char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+
+	close(fd);
+
+	if(file == MAP_FAILED || !validListFile(file, size)){
+		printf("%s is not a valid list file.\n", path);
+
+		if(file != NULL && file != MAP_FAILED) munmap(file, size);
+
+		return -1;
+	}
+
+	ListFileHeader * header = (ListFileHeader *) file;
+	ListFileRecord * records = (ListFileRecord *) (file + sizeof(ListFileHeader));
+	char * blob = (char *) (records + header->count);
+
+	madvise(file, size, MADV_SEQUENTIAL);
+
+	if(clearList(myList) < 0){
+		munmap(file, size);
+		return -1;
+	}
+
+	// Size the ring once up front instead of growing it while appending
+	if(myList->backend == LIST_RING && (int) header->count > myList->capacity){
+		setCapacity(myList, header->count);
+	}
+
+	for(uint32_t i = 0; i < header->count; i++){
+		insertToTail(myList, blob + records[i].name, blob + records[i].lastname, records[i].height, records[i].age);
+	}
+
+	munmap(file, size);
+
+	return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include "list.h"
+
+/*
+    Binary list file layout, in host byte order:
+        ListFileHeader
+        ListFileRecord[count]      one fixed-width record per entry, in list order
+        char blob[blobSize]        every name and lastname, NUL-terminated, back to back
+    Records refer to their names by offset into the blob.
+*/
+#define LIST_FILE_MAGIC 0x4c314150u
+#define LIST_FILE_VERSION 1
+
+typedef struct listFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t blobSize;
+} ListFileHeader;
+
+typedef struct listFileRecord
+{
+	float height;
+	int32_t age;
+	uint32_t name;
+	uint32_t lastname;
+} ListFileRecord;
+
+/*
+    returns -1 if the file cannot be written
+*/
+int saveList(List* myList, char* path);
+
+/*
+    Replaces the contents of myList with the entries saved in a list file. The file is
+    mapped and its records are appended straight from the mapping.
+    returns -1 if the file cannot be read or is not a valid list file
+*/
+int loadList(List* myList, char* path);
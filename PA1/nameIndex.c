@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nameIndex.h"
+
+// FNV-1a over the name bytes
+static unsigned hashName(char * name){
+	unsigned hash = 2166136261u;
+
+	for(; *name != '\0'; name++){
+		hash ^= (unsigned char) *name;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+NameIndex * initializeNameIndex(){
+	NameIndex * index = (NameIndex *) malloc(sizeof(NameIndex));
+
+	if(index == NULL){
+		printf("Unable to allocate memory for name index.\n");
+		return NULL;
+	}
+
+	index->buckets = (NameGroup **) calloc(NAME_INDEX_INITIAL_BUCKETS, sizeof(NameGroup *));
+
+	if(index->buckets == NULL){
+		printf("Unable to allocate memory for name index.\n");
+		free(index);
+		return NULL;
+	}
+
+	index->bucketCount = NAME_INDEX_INITIAL_BUCKETS;
+	index->count = 0;
+
+	return index;
+}
+
+static void freeGroup(NameGroup * group){
+	if(group->members != group->inlineMembers){
+		free(group->members);
+	}
+
+	free(group);
+}
+
+void deleteNameIndex(NameIndex * index){
+	if(index == NULL) return;
+
+	for(int i = 0; i < index->bucketCount; i++){
+		while(index->buckets[i] != NULL){
+			NameGroup * next = index->buckets[i]->nextSameBucket;
+			freeGroup(index->buckets[i]);
+			index->buckets[i] = next;
+		}
+	}
+
+	free(index->buckets);
+	free(index);
+}
+
+// Re-threads every chain into twice as many buckets. On failure the index just stays denser.
+static void growNameIndex(NameIndex * index){
+	int bucketCount = index->bucketCount * 2;
+	NameGroup ** buckets = (NameGroup **) calloc(bucketCount, sizeof(NameGroup *));
+
+	if(buckets == NULL) return;
+
+	for(int i = 0; i < index->bucketCount; i++){
+		NameGroup * group = index->buckets[i];
+
+		while(group != NULL){
+			NameGroup * next = group->nextSameBucket;
+			unsigned bucket = group->hash & (bucketCount - 1);
+
+			group->nextSameBucket = buckets[bucket];
+			buckets[bucket] = group;
+			group = next;
+		}
+	}
+
+	free(index->buckets);
+	index->buckets = buckets;
+	index->bucketCount = bucketCount;
+}
+
+// Returns the link to the group for name in its bucket, or the NULL ending the bucket if there is none.
+static NameGroup ** findGroup(NameIndex * index, char * name, unsigned hash){
+	NameGroup ** link = &index->buckets[hash & (index->bucketCount - 1)];
+
+	while(*link != NULL && ((*link)->hash != hash || strcmp(name, (*link)->members[0]->name) != 0)){
+		link = &(*link)->nextSameBucket;
+	}
+
+	return link;
+}
+
+static NameGroup * newGroup(unsigned hash){
+	NameGroup * group = (NameGroup *) malloc(sizeof(NameGroup));
+
+	if(group == NULL) return NULL;
+
+	group->members = group->inlineMembers;
+	group->hash = hash;
+	group->count = 0;
+	group->capacity = NAME_GROUP_INITIAL_MEMBERS;
+	group->settled = 0;
+	group->first = NULL;
+
+	return group;
+}
+
+int nameIndexAdd(NameIndex * index, Entry * entry){
+	unsigned hash = hashName(entry->name);
+	NameGroup ** link = findGroup(index, entry->name, hash);
+	NameGroup * group = *link;
+
+	if(group == NULL){
+		if((group = newGroup(hash)) == NULL){
+			printf("Unable to allocate memory for name index.\n");
+			return -1;
+		}
+
+		group->nextSameBucket = NULL;
+		*link = group;
+		index->count++;
+
+		if(index->count > index->bucketCount){
+			growNameIndex(index);
+		}
+	}
+
+	if(group->count == group->capacity){
+		Entry ** old = (group->members != group->inlineMembers) ? group->members : NULL;
+		Entry ** members = (Entry **) realloc(old, sizeof(Entry *) * group->capacity * 2);
+
+		if(members == NULL){
+			printf("Unable to allocate memory for name index.\n");
+			return -1;
+		}
+
+		if(old == NULL){
+			memcpy(members, group->inlineMembers, sizeof(Entry *) * group->count);
+		}
+
+		group->members = members;
+		group->capacity *= 2;
+	}
+
+	entry->member = group->count;
+	group->members[group->count++] = entry;
+
+	return 0;
+}
+
+// Moves the member at index from of a group to index to, which is free.
+static void moveMember(NameGroup * group, int to, int from){
+	group->members[to] = group->members[from];
+	group->members[to]->member = to;
+}
+
+void nameIndexRemove(NameIndex * index, Entry * entry){
+	unsigned hash = hashName(entry->name);
+	NameGroup ** link = findGroup(index, entry->name, hash);
+	NameGroup * group = *link;
+	int hole = entry->member;
+
+	if(group == NULL || hole >= group->count || group->members[hole] != entry) return;
+
+	if(--group->count == 0){
+		*link = group->nextSameBucket;
+		freeGroup(group);
+		index->count--;
+		return;
+	}
+
+	// The settled members stay in front: the last of them fills a hole among them,
+	// and the last member overall fills whatever hole is left
+	if(hole < group->settled){
+		moveMember(group, hole, --group->settled);
+		hole = group->settled;
+	}
+
+	if(hole != group->count){
+		moveMember(group, hole, group->count);
+	}
+
+	// Without its first entry the group has to be ranked afresh
+	if(entry == group->first){
+		group->first = NULL;
+		group->settled = 0;
+	}
+}
+
+int nameIndexPosition(NameIndex * index, List * myList, char * name){
+	NameGroup * group = *findGroup(index, name, hashName(name));
+
+	if(group == NULL) return -1;
+
+	int position = (group->first != NULL) ? listRank(myList, group->first) : -1;
+
+	for(int i = group->settled; i < group->count; i++){
+		int rank = listRank(myList, group->members[i]);
+
+		if(position == -1 || rank < position){
+			position = rank;
+			group->first = group->members[i];
+		}
+	}
+
+	group->settled = group->count;
+
+	return position;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "list.h"
+
+#define NAME_INDEX_INITIAL_BUCKETS 16
+#define NAME_GROUP_INITIAL_MEMBERS 2
+
+/*
+    The entries carrying one name, in no particular order; each entry's member field is
+    its index in members, which points at the group's own few slots until it outgrows
+    them. first is the one at the smallest logical index among
+    members[0, settled), or NULL if that is not known. The members from settled on were
+    added since and have not been ranked against it yet.
+*/
+typedef struct nameGroup
+{
+	struct nameGroup* nextSameBucket;
+	unsigned hash;
+	int count;
+	int capacity;
+	int settled;
+	Entry* first;
+	Entry** members;
+	Entry* inlineMembers[NAME_GROUP_INITIAL_MEMBERS];
+} NameGroup;
+
+/*
+    Chained hash table from name to the group of entries carrying it. The table doubles
+    once it holds more groups than buckets.
+*/
+typedef struct nameIndex
+{
+	NameGroup** buckets;
+	int bucketCount;
+	int count;
+} NameIndex;
+
+NameIndex* initializeNameIndex();
+
+void deleteNameIndex(NameIndex* index);
+
+/*
+    returns -1 if the entry's group could not be allocated or grown
+*/
+int nameIndexAdd(NameIndex* index, Entry* entry);
+
+void nameIndexRemove(NameIndex* index, Entry* entry);
+
+/*
+    returns the logical index in myList of the first entry named name, or -1 if there is
+    none. Only the group's first entry and the members added since the last lookup are
+    ranked, so repeated lookups of a name rank one entry each.
+*/
+int nameIndexPosition(NameIndex* index, List* myList, char* name);
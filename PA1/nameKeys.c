@@ -0,0 +1,79 @@
+#include <string.h>
+#include "nameKeys.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NAME_KEYS_SIMD 1
+#endif
+
+uint64_t nameKey(const char * name, int * length){
+	uint64_t key = 0;
+	int n = strlen(name);
+
+	memcpy(&key, name, (n < NAME_KEY_BYTES) ? n : NAME_KEY_BYTES);
+	*length = n;
+
+	return key;
+}
+
+static int scanScalar(const uint64_t * keys, int from, int to, uint64_t key){
+	for(int i = from; i < to; i++){
+		if(keys[i] == key) return i;
+	}
+
+	return to;
+}
+
+#ifdef NAME_KEYS_SIMD
+// Four keys per compare; the mask has one bit per 64-bit lane that matched
+__attribute__((target("avx2")))
+static int scanAvx2(const uint64_t * keys, int from, int to, uint64_t key){
+	__m256i needle = _mm256_set1_epi64x((long long) key);
+	int i = from;
+
+	for(; i + 4 <= to; i += 4){
+		__m256i block = _mm256_loadu_si256((const __m256i *) (keys + i));
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(block, needle)));
+
+		if(mask != 0) return i + __builtin_ctz(mask);
+	}
+
+	return scanScalar(keys, i, to, key);
+}
+
+__attribute__((target("sse4.2")))
+static int scanSse(const uint64_t * keys, int from, int to, uint64_t key){
+	__m128i needle = _mm_set1_epi64x((long long) key);
+	int i = from;
+
+	for(; i + 2 <= to; i += 2){
+		__m128i block = _mm_loadu_si128((const __m128i *) (keys + i));
+		int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(block, needle)));
+
+		if(mask != 0) return i + __builtin_ctz(mask);
+	}
+
+	return scanScalar(keys, i, to, key);
+}
+#endif
+
+static int (*scanKeys)(const uint64_t *, int, int, uint64_t) = NULL;
+
+int nameKeyScan(const uint64_t * keys, int from, int to, uint64_t key){
+	// Pick the widest compare this CPU supports the first time through
+	if(scanKeys == NULL){
+		scanKeys = scanScalar;
+
+#ifdef NAME_KEYS_SIMD
+		__builtin_cpu_init();
+
+		if(__builtin_cpu_supports("avx2")){
+			scanKeys = scanAvx2;
+		}else if(__builtin_cpu_supports("sse4.2")){
+			scanKeys = scanSse;
+		}
+#endif
+	}
+
+	return scanKeys(keys, from, to, key);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+// Bytes of a name packed into its key; shorter names are padded with zeros.
+#define NAME_KEY_BYTES 8
+
+/*
+    The key of a name is its first NAME_KEY_BYTES bytes read as one integer, and its length
+    rides alongside. A ring list without a name index keeps both for every slot in arrays parallel to its data, so
+    a name scan walks two dense arrays and only dereferences entries whose key and length
+    both match. Keys are compared for equality only, so byte order does not matter.
+*/
+uint64_t nameKey(const char* name, int* length);
+
+/*
+    returns the first index in [from, to) holding key, or to if there is none;
+    uses AVX2 or SSE4.2 when the CPU has them
+*/
+int nameKeyScan(const uint64_t* keys, int from, int to, uint64_t key);
@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "script.h"
+#include "listStore.h"
+#include "sortView.h"
+#include "snapshot.h"
+
+// Perfect hash over the command names: the length and three of the characters pick one of
+// COMMAND_SLOTS slots, and the multipliers were chosen so that no two commands share a slot.
+// A token still has to match the name in its slot exactly, so anything else is rejected.
+#define COMMAND_SLOTS 32
+#define COMMAND_HASH(length, first, middle, last) \
+	(((length) * 3 + (first) * 11 + (middle) + (last) * 5) & (COMMAND_SLOTS - 1))
+#define COMMAND(name, first, middle, last, id) \
+	[COMMAND_HASH(sizeof(name) - 1, first, middle, last)] = { name, sizeof(name) - 1, id }
+
+typedef struct command
+{
+	const char* name;
+	int length;
+	CommandId id;
+} Command;
+
+// The characters passed to COMMAND are the first, middle (name[length / 2]) and last ones
+static const Command commandTable[COMMAND_SLOTS] = {
+	COMMAND("insertToHead", 'i', 'T', 'd', CMD_INSERT_TO_HEAD),
+	COMMAND("insertToTail", 'i', 'T', 'l', CMD_INSERT_TO_TAIL),
+	COMMAND("insertToPosition", 'i', 'P', 'n', CMD_INSERT_TO_POSITION),
+	COMMAND("findPosition", 'f', 's', 'n', CMD_FIND_POSITION),
+	COMMAND("deleteFromHead", 'd', 'r', 'd', CMD_DELETE_FROM_HEAD),
+	COMMAND("deleteFromTail", 'd', 'r', 'l', CMD_DELETE_FROM_TAIL),
+	COMMAND("deleteFromPosition", 'd', 'm', 'n', CMD_DELETE_FROM_POSITION),
+	COMMAND("printList", 'p', 't', 't', CMD_PRINT_LIST),
+	COMMAND("printListInfo", 'p', 'i', 'o', CMD_PRINT_LIST_INFO),
+	COMMAND("deleteList", 'd', 'e', 't', CMD_DELETE_LIST),
+	COMMAND("reserve", 'r', 'e', 'e', CMD_RESERVE),
+	COMMAND("shrinkToFit", 's', 'k', 't', CMD_SHRINK_TO_FIT),
+	COMMAND("save", 's', 'v', 'e', CMD_SAVE),
+	COMMAND("load", 'l', 'a', 'd', CMD_LOAD),
+	COMMAND("sortBy", 's', 't', 'y', CMD_SORT_BY),
+	COMMAND("printSorted", 'p', 'S', 'd', CMD_PRINT_SORTED),
+	COMMAND("snapshot", 's', 's', 't', CMD_SNAPSHOT),
+	COMMAND("snapshotWait", 's', 'o', 't', CMD_SNAPSHOT_WAIT),
+};
+
+// Exact powers of ten a decimal mantissa can be divided by without extra rounding
+static const double powersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+int openScript(Script * script, char * path){
+	int fd = open(path, O_RDONLY);
+	struct stat info;
+
+	if(fd < 0) return -1;
+
+	if(fstat(fd, &info) < 0){
+		close(fd);
+		return -1;
+	}
+
+	script->text = NULL;
+	script->length = 0;
+	script->mapped = 0;
+
+	// A private writable mapping lets fields be terminated in place without touching the file
+	if(S_ISREG(info.st_mode) && info.st_size > 0){
+		void * text = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+		if(text != MAP_FAILED){
+			madvise(text, info.st_size, MADV_SEQUENTIAL);
+			script->text = (char *) text;
+			script->length = info.st_size;
+			script->mapped = 1;
+			close(fd);
+			return 0;
+		}
+	}
+
+	// Pipes and other unmappable inputs are read into a heap buffer instead
+	size_t capacity = 4096;
+	ssize_t got;
+
+	script->text = (char *) malloc(capacity);
+
+	while(script->text != NULL && (got = read(fd, script->text + script->length, capacity - script->length)) > 0){
+		script->length += got;
+
+		if(script->length == capacity){
+			char * grown = (char *) realloc(script->text, capacity * 2);
+
+			if(grown == NULL){
+				free(script->text);
+				script->text = NULL;
+				break;
+			}
+
+			script->text = grown;
+			capacity *= 2;
+		}
+	}
+
+	close(fd);
+
+	return script->text == NULL ? -1 : 0;
+}
+
+void closeScript(Script * script){
+	if(script->mapped){
+		munmap(script->text, script->length);
+	}else{
+		free(script->text);
+	}
+
+	script->text = NULL;
+	script->length = 0;
+}
+
+CommandId lookupCommand(char * token, int length){
+	if(length == 0) return CMD_INVALID;
+
+	const Command * command = &commandTable[COMMAND_HASH(length, (unsigned char) token[0], (unsigned char) token[length / 2], (unsigned char) token[length - 1])];
+
+	if(command->name == NULL || command->length != length || memcmp(command->name, token, length) != 0){
+		return CMD_INVALID;
+	}
+
+	return command->id;
+}
+
+// Cuts the next space-separated field out of a NUL-terminated line, terminating it in place.
+// Returns an empty string once the line has no fields left.
+static char * nextField(char ** cursor, int * length){
+	char * start = *cursor;
+
+	while(*start == ' '){
+		start++;
+	}
+
+	char * end = start;
+
+	while(*end != ' ' && *end != '\0'){
+		end++;
+	}
+
+	*cursor = (*end == '\0') ? end : end + 1;
+	*end = '\0';
+
+	if(length != NULL){
+		*length = end - start;
+	}
+
+	return start;
+}
+
+// atoi without the locale and whitespace handling
+static int parseInt(char * text){
+	int negative = 0;
+	int value = 0;
+
+	if(*text == '-' || *text == '+'){
+		negative = (*text == '-');
+		text++;
+	}
+
+	for(; *text >= '0' && *text <= '9'; text++){
+		value = value * 10 + (*text - '0');
+	}
+
+	return negative ? -value : value;
+}
+
+// atof for plain decimals such as "1.76". The digits are gathered into an exact integer and
+// divided once by an exact power of ten, which rounds the same way strtod does; anything
+// longer or fancier (exponents, inf, nan) is handed to atof.
+static double parseDecimal(char * text){
+	char * p = text;
+	int negative = 0;
+	unsigned long long mantissa = 0;
+	int digits = 0;
+	int scale = 0;
+
+	if(*p == '-' || *p == '+'){
+		negative = (*p == '-');
+		p++;
+	}
+
+	for(; *p >= '0' && *p <= '9'; p++, digits++){
+		mantissa = mantissa * 10 + (*p - '0');
+	}
+
+	if(*p == '.'){
+		for(p++; *p >= '0' && *p <= '9'; p++, digits++, scale++){
+			mantissa = mantissa * 10 + (*p - '0');
+		}
+	}
+
+	if(*p != '\0' || digits == 0 || digits > 15){
+		return atof(text);
+	}
+
+	double value = (double) mantissa / powersOfTen[scale];
+
+	return negative ? -value : value;
+}
+
+// Positional edits are the ones a batch can hold back; anything else sees the list as is
+static int batchable(CommandId id){
+	return id == CMD_INSERT_TO_HEAD || id == CMD_INSERT_TO_TAIL || id == CMD_INSERT_TO_POSITION ||
+		id == CMD_DELETE_FROM_HEAD || id == CMD_DELETE_FROM_TAIL || id == CMD_DELETE_FROM_POSITION;
+}
+
+static List * runCommand(List * myList, Batch * batch, char * line){
+	int length;
+	char * token = nextField(&line, &length);
+
+	if(length == 0) return myList;
+
+	CommandId id = lookupCommand(token, length);
+
+	// Without a list every edit falls through to the list functions for their messages
+	int batched = (batch != NULL && myList != NULL);
+
+	if(batch != NULL && !batchable(id)){
+		flushBatch(batch, myList);
+	}
+
+	switch(id){
+		case CMD_INSERT_TO_HEAD:
+		case CMD_INSERT_TO_TAIL:
+		{
+			char * name = nextField(&line, NULL);
+			char * lastname = nextField(&line, NULL);
+			float height = parseDecimal(nextField(&line, NULL));
+			int age = parseInt(nextField(&line, NULL));
+
+			if(batched){
+				batchInsert(batch, myList, (id == CMD_INSERT_TO_HEAD) ? 0 : batchSize(batch, myList), name, lastname, height, age);
+			}else if(id == CMD_INSERT_TO_HEAD){
+				insertToHead(myList, name, lastname, height, age);
+			}else{
+				insertToTail(myList, name, lastname, height, age);
+			}
+			break;
+		}
+		case CMD_INSERT_TO_POSITION:
+		{
+			int position = parseInt(nextField(&line, NULL));
+			char * name = nextField(&line, NULL);
+			char * lastname = nextField(&line, NULL);
+			float height = parseDecimal(nextField(&line, NULL));
+			int age = parseInt(nextField(&line, NULL));
+
+			if(batched){
+				batchInsert(batch, myList, position, name, lastname, height, age);
+			}else{
+				insertToPosition(myList, position, name, lastname, height, age);
+			}
+			break;
+		}
+		case CMD_FIND_POSITION:
+			printf("%d\n", findPosition(myList, nextField(&line, NULL)));
+			break;
+		case CMD_DELETE_FROM_HEAD:
+		case CMD_DELETE_FROM_TAIL:
+			// An empty list has its own message for these, so leave that case to the list
+			if(batched && batchSize(batch, myList) > 0){
+				batchDelete(batch, myList, (id == CMD_DELETE_FROM_HEAD) ? 0 : batchSize(batch, myList) - 1);
+				break;
+			}
+
+			if(batch != NULL){
+				flushBatch(batch, myList);
+			}
+
+			if(id == CMD_DELETE_FROM_HEAD){
+				deleteFromHead(myList);
+			}else{
+				deleteFromTail(myList);
+			}
+			break;
+		case CMD_DELETE_FROM_POSITION:
+		{
+			int position = parseInt(nextField(&line, NULL));
+
+			if(batched){
+				batchDelete(batch, myList, position);
+			}else{
+				deleteFromPosition(myList, position);
+			}
+			break;
+		}
+		case CMD_PRINT_LIST:
+			printList(myList);
+			break;
+		case CMD_PRINT_LIST_INFO:
+			printListInfo(myList);
+			break;
+		case CMD_RESERVE:
+			reserve(myList, parseInt(nextField(&line, NULL)));
+			break;
+		case CMD_SHRINK_TO_FIT:
+			shrinkToFit(myList);
+			break;
+		case CMD_SAVE:
+			saveList(myList, nextField(&line, NULL));
+			break;
+		case CMD_LOAD:
+			loadList(myList, nextField(&line, NULL));
+			break;
+		case CMD_SORT_BY:
+			setSortKey(myList, nextField(&line, NULL));
+			break;
+		case CMD_PRINT_SORTED:
+			printSorted(myList);
+			break;
+		case CMD_SNAPSHOT:
+			exportSnapshot(myList, nextField(&line, NULL));
+			break;
+		case CMD_SNAPSHOT_WAIT:
+			waitSnapshots(myList);
+			break;
+		case CMD_DELETE_LIST:
+			deleteList(myList);
+			return NULL;
+		default:
+			printf("Invalid command: <%s>\n", token);
+			break;
+	}
+
+	return myList;
+}
+
+List * runScript(List * myList, Batch * batch, Script * script){
+	char * text = script->text;
+	char * end = script->text + script->length;
+
+	while(text < end){
+		char * newline = (char *) memchr(text, '\n', end - text);
+
+		if(newline == NULL){
+			// The last line has no newline to overwrite, so it is terminated in a copy
+			size_t length = end - text;
+			char * last = (char *) malloc(length + 1);
+
+			if(last == NULL){
+				printf("Unable to allocate memory for the last command.\n");
+				break;
+			}
+
+			memcpy(last, text, length);
+			last[length] = '\0';
+			myList = runCommand(myList, batch, last);
+			free(last);
+			break;
+		}
+
+		*newline = '\0';
+		myList = runCommand(myList, batch, text);
+		text = newline + 1;
+	}
+
+	if(batch != NULL && myList != NULL){
+		flushBatch(batch, myList);
+	}
+
+	return myList;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include "list.h"
+#include "batch.h"
+
+// Commands the interpreter understands
+typedef enum commandId
+{
+	CMD_INVALID,
+	CMD_INSERT_TO_HEAD,
+	CMD_INSERT_TO_TAIL,
+	CMD_INSERT_TO_POSITION,
+	CMD_FIND_POSITION,
+	CMD_DELETE_FROM_HEAD,
+	CMD_DELETE_FROM_TAIL,
+	CMD_DELETE_FROM_POSITION,
+	CMD_PRINT_LIST,
+	CMD_PRINT_LIST_INFO,
+	CMD_DELETE_LIST,
+	CMD_RESERVE,
+	CMD_SHRINK_TO_FIT,
+	CMD_SAVE,
+	CMD_LOAD,
+	CMD_SORT_BY,
+	CMD_PRINT_SORTED,
+	CMD_SNAPSHOT,
+	CMD_SNAPSHOT_WAIT
+} CommandId;
+
+// A command script held in memory, either mapped from its file or read into a heap buffer.
+typedef struct script
+{
+	char* text;
+	size_t length;
+	int mapped;
+} Script;
+
+/*
+    returns -1 if the file cannot be opened or read
+*/
+int openScript(Script* script, char* path);
+
+void closeScript(Script* script);
+
+/*
+    looks a command name of the given length up in the perfect hash table
+*/
+CommandId lookupCommand(char* token, int length);
+
+/*
+    Runs every command in the script against myList and returns the list, which is NULL
+    once a deleteList command has run. Fields are cut out of the script text in place, so
+    names reach the list as pointers into the script rather than copies.
+    With a batch, positional edits are held back and applied together just before any
+    other command and at the end of the script; pass NULL to apply each one as it comes.
+*/
+List* runScript(List* myList, Batch* batch, Script* script);
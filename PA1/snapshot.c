@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+Snapshot * takeSnapshot(List * myList){
+	Snapshot * snapshot = (Snapshot *) calloc(1, sizeof(Snapshot));
+
+	if(snapshot == NULL){
+		printf("Unable to allocate memory for snapshot.\n");
+		return NULL;
+	}
+
+	snapshot->list = myList;
+	snapshot->size = myList->size;
+
+	if(myList->backend == LIST_CHUNKED && myList->chunks->chunks > 0){
+		snapshot->parts = (SnapshotPart *) malloc(sizeof(SnapshotPart) * myList->chunks->chunks);
+
+		if(snapshot->parts == NULL){
+			printf("Unable to allocate memory for snapshot.\n");
+			free(snapshot);
+			return NULL;
+		}
+
+		for(Chunk * node = chunkFirst(myList->chunks); node != NULL; node = chunkNext(node)){
+			SnapshotPart * part = &snapshot->parts[snapshot->partCount++];
+
+			part->items = node->items;
+			part->count = node->count;
+			chunkItemsRetain(node->items);
+		}
+	}else if(myList->backend == LIST_RING && myList->size > 0){
+		snapshot->entries = (Entry **) malloc(sizeof(Entry *) * myList->size);
+
+		if(snapshot->entries == NULL){
+			printf("Unable to allocate memory for snapshot.\n");
+			free(snapshot);
+			return NULL;
+		}
+
+		// Unwrap the ring: from head to the end of the block, then from its start
+		int first = (myList->capacity - myList->head < myList->size) ? myList->capacity - myList->head : myList->size;
+
+		memcpy(snapshot->entries, myList->data + myList->head, sizeof(Entry *) * first);
+		memcpy(snapshot->entries + first, myList->data, sizeof(Entry *) * (myList->size - first));
+	}
+
+	__atomic_add_fetch(&myList->snapshots, 1, __ATOMIC_RELAXED);
+
+	return snapshot;
+}
+
+void releaseSnapshot(Snapshot * snapshot){
+	List * myList = snapshot->list;
+
+	for(int i = 0; i < snapshot->partCount; i++){
+		chunkItemsRelease(snapshot->parts[i].items);
+	}
+
+	free(snapshot->parts);
+	free(snapshot->entries);
+	free(snapshot);
+
+	// Last, since the list may free the parked entries as soon as this reaches zero
+	__atomic_sub_fetch(&myList->snapshots, 1, __ATOMIC_RELEASE);
+}
+
+void snapshotIterBegin(Snapshot * snapshot, SnapshotIter * iter){
+	iter->snapshot = snapshot;
+	iter->index = 0;
+	iter->part = 0;
+	iter->offset = 0;
+}
+
+Entry * snapshotIterNext(SnapshotIter * iter){
+	Snapshot * snapshot = iter->snapshot;
+
+	if(iter->index >= snapshot->size){
+		return NULL;
+	}
+
+	iter->index++;
+
+	if(snapshot->parts == NULL){
+		return snapshot->entries[iter->index - 1];
+	}
+
+	while(iter->offset == snapshot->parts[iter->part].count){
+		iter->part++;
+		iter->offset = 0;
+	}
+
+	return snapshot->parts[iter->part].items->slots[iter->offset++];
+}
+
+static void * exportThread(void * arg){
+	SnapshotJob * job = (SnapshotJob *) arg;
+	OutBuffer out;
+	SnapshotIter iter;
+	Entry * entry;
+
+	outInit(&out, job->fd);
+
+	if(job->snapshot->size == 0){
+		outText(&out, "List is empty!\n");
+	}
+
+	snapshotIterBegin(job->snapshot, &iter);
+
+	while((entry = snapshotIterNext(&iter)) != NULL){
+		outEntry(&out, iter.index - 1, entry);
+	}
+
+	outFlush(&out);
+	close(job->fd);
+	releaseSnapshot(job->snapshot);
+	__atomic_store_n(&job->done, 1, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+// Joins the exports that have finished, or every export with wait set.
+static void joinJobs(List * myList, int wait){
+	SnapshotJob ** link = &myList->jobs;
+
+	while(*link != NULL){
+		SnapshotJob * job = *link;
+
+		if(!wait && !__atomic_load_n(&job->done, __ATOMIC_ACQUIRE)){
+			link = &job->next;
+			continue;
+		}
+
+		pthread_join(job->thread, NULL);
+		*link = job->next;
+		free(job);
+	}
+
+	listFreeParked(myList);
+}
+
+int exportSnapshot(List * myList, char * path){
+	if(myList == NULL){
+		printf("No list to snapshot!\n");
+		return -1;
+	}
+
+	joinJobs(myList, 0);
+
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if(fd < 0){
+		printf("Unable to open %s for snapshot.\n", path);
+		return -1;
+	}
+
+	SnapshotJob * job = (SnapshotJob *) malloc(sizeof(SnapshotJob));
+
+	if(job == NULL || (job->snapshot = takeSnapshot(myList)) == NULL){
+		if(job == NULL) printf("Unable to allocate memory for snapshot.\n");
+
+		free(job);
+		close(fd);
+		return -1;
+	}
+
+	job->fd = fd;
+	job->done = 0;
+
+	if(pthread_create(&job->thread, NULL, exportThread, job) != 0){
+		printf("Unable to start snapshot thread.\n");
+		releaseSnapshot(job->snapshot);
+		free(job);
+		close(fd);
+		return -1;
+	}
+
+	job->next = myList->jobs;
+	myList->jobs = job;
+
+	return 0;
+}
+
+void waitSnapshots(List * myList){
+	if(myList == NULL){
+		printf("No list to wait on!\n");
+		return;
+	}
+
+	joinJobs(myList, 1);
+}
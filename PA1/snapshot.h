@@ -0,0 +1,71 @@
+#pragma once
+
+#include <pthread.h>
+#include "list.h"
+
+// The entries of one chunk as they stood when the snapshot was taken
+typedef struct snapshotPart
+{
+	ChunkItems* items;
+	int count;
+} SnapshotPart;
+
+/*
+    An immutable view of a list as it stood when taken, safe to read from another thread
+    while the list keeps changing. A chunked list's snapshot shares the chunks' items arrays,
+    which edits copy before touching (see ChunkItems), so taking one costs a pointer per chunk.
+    A ring has no chunks to share, so its snapshot is not copy-on-write: taking one copies
+    all n entry pointers on the editing thread, and only the export itself runs alongside.
+    Entries the list drops while any snapshot is live are parked rather than freed.
+*/
+typedef struct snapshot
+{
+	List* list;
+	int size;
+	int partCount;
+	SnapshotPart* parts;
+	Entry** entries;
+} Snapshot;
+
+typedef struct snapshotIter
+{
+	Snapshot* snapshot;
+	int index;
+	int part;
+	int offset;
+} SnapshotIter;
+
+// An export of a snapshot running on its own thread
+typedef struct snapshotJob
+{
+	pthread_t thread;
+	Snapshot* snapshot;
+	int fd;
+	int done;
+	struct snapshotJob* next;
+} SnapshotJob;
+
+/*
+    takeSnapshot returns NULL if the view cannot be allocated. releaseSnapshot may be
+    called from any thread; takeSnapshot only from the one editing the list.
+*/
+Snapshot* takeSnapshot(List* myList);
+void releaseSnapshot(Snapshot* snapshot);
+
+void snapshotIterBegin(Snapshot* snapshot, SnapshotIter* iter);
+
+/*
+    returns NULL once every entry has been visited
+*/
+Entry* snapshotIterNext(SnapshotIter* iter);
+
+/*
+    Starts a thread writing the list as printList would print it to path, and returns
+    without waiting for it; returns -1 if the file or the thread cannot be set up.
+*/
+int exportSnapshot(List* myList, char* path);
+
+/*
+    waits for every export of the list to finish, then frees the entries parked for them
+*/
+void waitSnapshots(List* myList);
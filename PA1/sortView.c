@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sortView.h"
+#include "nameKeys.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+typedef struct sortRecord
+{
+	uint64_t key;
+	Entry* entry;
+} SortRecord;
+
+int setSortKey(List * myList, char * field){
+	if(myList == NULL){
+		printf("No list to sort!\n");
+		return -1;
+	}
+
+	if(strcmp(field, "age") == 0){
+		myList->sortKey = SORT_AGE;
+	}else if(strcmp(field, "height") == 0){
+		myList->sortKey = SORT_HEIGHT;
+	}else if(strcmp(field, "name") == 0){
+		myList->sortKey = SORT_NAME;
+	}else{
+		printf("Cannot sort by <%s>.\n", field);
+		return -1;
+	}
+
+	return 0;
+}
+
+// Flipping the sign bit orders two's complement ints as unsigned ones
+static uint64_t ageKey(int age){
+	return (uint32_t) age ^ 0x80000000u;
+}
+
+// IEEE floats order like sign-magnitude ints: set the sign bit of positive values and
+// invert every bit of negative ones, and the bit patterns order as unsigned ints.
+// -0 is folded into 0 first so the two compare equal, as they do as floats.
+static uint64_t heightKey(float height){
+	uint32_t bits;
+
+	if(height == 0.0f) height = 0.0f;
+
+	memcpy(&bits, &height, sizeof(bits));
+
+	return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/*
+    Stable LSD radix sort of n records on the low `bytes` bytes of their keys, one byte per
+    pass. The counts for every byte are gathered in a single read of the keys up front, and a
+    pass whose byte is the same in every key is skipped. Returns whichever of records and
+    scratch holds the result.
+*/
+static SortRecord * radixSort(SortRecord * records, SortRecord * scratch, int n, int bytes){
+	int (*counts)[RADIX_BUCKETS] = calloc(bytes, sizeof(*counts));
+
+	if(counts == NULL) return NULL;
+
+	for(int i = 0; i < n; i++){
+		for(int b = 0; b < bytes; b++){
+			counts[b][(records[i].key >> (b * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+		}
+	}
+
+	for(int b = 0; b < bytes; b++){
+		int shift = b * RADIX_BITS;
+
+		if(counts[b][(records[0].key >> shift) & (RADIX_BUCKETS - 1)] == n) continue;
+
+		int offset = 0;
+
+		for(int d = 0; d < RADIX_BUCKETS; d++){
+			int count = counts[b][d];
+
+			counts[b][d] = offset;
+			offset += count;
+		}
+
+		for(int i = 0; i < n; i++){
+			scratch[counts[b][(records[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = records[i];
+		}
+
+		SortRecord * swap = records;
+
+		records = scratch;
+		scratch = swap;
+	}
+
+	free(counts);
+
+	return records;
+}
+
+// Stable merge sort by full name, for runs whose keys only hold the first bytes of the names.
+static void mergeByName(SortRecord * records, SortRecord * scratch, int n){
+	if(n < 2) return;
+
+	int half = n / 2;
+
+	mergeByName(records, scratch, half);
+	mergeByName(records + half, scratch, n - half);
+
+	if(strcmp(records[half - 1].entry->name, records[half].entry->name) <= 0) return;
+
+	int i = 0;
+	int j = half;
+	int k = 0;
+
+	while(i < half && j < n){
+		scratch[k++] = (strcmp(records[j].entry->name, records[i].entry->name) < 0) ? records[j++] : records[i++];
+	}
+
+	while(i < half) scratch[k++] = records[i++];
+	while(j < n) scratch[k++] = records[j++];
+
+	memcpy(records, scratch, sizeof(SortRecord) * n);
+}
+
+// Reads the key for the list's sort order out of each entry, in list order.
+static void gatherKeys(List * myList, SortRecord * records){
+	ListIter iter;
+	Entry * entry;
+	int i = 0;
+
+	listIterBegin(myList, &iter);
+
+	while((entry = listIterNext(&iter)) != NULL){
+		int length;
+
+		records[i].entry = entry;
+
+		if(myList->sortKey == SORT_AGE){
+			records[i].key = ageKey(entry->age);
+		}else if(myList->sortKey == SORT_HEIGHT){
+			records[i].key = heightKey(entry->height);
+		}else if(myList->keys != NULL){
+			// The ring already holds every name's key; big-endian makes it order like the bytes
+			records[i].key = __builtin_bswap64(myList->keys[listSlot(myList, i)]);
+		}else{
+			records[i].key = __builtin_bswap64(nameKey(entry->name, &length));
+		}
+
+		i++;
+	}
+}
+
+Entry ** sortedView(List * myList){
+	if(myList == NULL || myList->size == 0 || myList->sortKey == SORT_NONE){
+		return NULL;
+	}
+
+	int n = myList->size;
+	SortRecord * records = (SortRecord *) malloc(sizeof(SortRecord) * n);
+	SortRecord * scratch = (SortRecord *) malloc(sizeof(SortRecord) * n);
+	Entry ** view = (Entry **) malloc(sizeof(Entry *) * n);
+
+	if(records == NULL || scratch == NULL || view == NULL){
+		printf("Unable to allocate memory for sorted view.\n");
+		free(records);
+		free(scratch);
+		free(view);
+		return NULL;
+	}
+
+	gatherKeys(myList, records);
+
+	SortRecord * sorted = radixSort(records, scratch, n, (myList->sortKey == SORT_NAME) ? NAME_KEY_BYTES : 4);
+
+	if(sorted == NULL){
+		printf("Unable to allocate memory for sorted view.\n");
+		free(records);
+		free(scratch);
+		free(view);
+		return NULL;
+	}
+
+	SortRecord * spare = (sorted == records) ? scratch : records;
+
+	// Names that share their first bytes tie on the key; only those runs need strcmp
+	if(myList->sortKey == SORT_NAME){
+		for(int start = 0, end; start < n; start = end){
+			for(end = start + 1; end < n && sorted[end].key == sorted[start].key; end++);
+
+			mergeByName(sorted + start, spare, end - start);
+		}
+	}
+
+	for(int i = 0; i < n; i++){
+		view[i] = sorted[i].entry;
+	}
+
+	free(records);
+	free(scratch);
+
+	return view;
+}
+
+void printSorted(List * myList){
+	if(myList == NULL){
+		printf("No list to print!\n");
+		return;
+	}
+
+	if(myList->sortKey == SORT_NONE){
+		printf("No sort order set! Use sortBy first.\n");
+		return;
+	}
+
+	if(myList->size == 0){
+		printf("List is empty!\n");
+		return;
+	}
+
+	static OutBuffer out;
+	Entry ** view = sortedView(myList);
+
+	if(view == NULL) return;
+
+	fflush(stdout);
+	outInit(&out, STDOUT_FILENO);
+
+	for(int i = 0; i < myList->size; i++){
+		outEntry(&out, i, view[i]);
+	}
+
+	outFlush(&out);
+	free(view);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "list.h"
+
+/*
+    A sorted view is an array of the list's entries ordered by the list's sort key, built
+    with an LSD radix sort over one integer key per entry; the list and its entries are left
+    where they are. Ages and heights sort as numbers and names by strcmp, and entries with
+    equal keys keep their order in the list.
+*/
+
+/*
+    field is age, height or name; returns -1 for anything else
+*/
+int setSortKey(List* myList, char* field);
+
+/*
+    returns an array of the list's size entries in sorted order for the caller to free,
+    or NULL if the list is empty, has no sort key, or the array cannot be allocated
+*/
+Entry** sortedView(List* myList);
+
+/*
+    prints the list in its sorted order, numbered by position in that order
+*/
+void printSorted(List* myList);
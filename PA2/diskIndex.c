@@ -0,0 +1,357 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "diskIndex.h"
+#include "outBuffer.h"
+
+static void outVarint(OutBuffer *, uint32_t);
+static int readVarint(unsigned char **, unsigned char *, int *);
+static uint64_t align8(uint64_t);
+static int sectionFits(uint64_t, uint64_t, uint64_t, uint64_t);
+static int compareTops(const void *, const void *);
+static int collectTops(Trie *, IndexTop **);
+static int writeSection(FILE *, void *, uint64_t, uint64_t);
+static unsigned char *decodeWord(DiskIndex *, unsigned char *, int, char *, int *);
+static unsigned char *bucketStart(DiskIndex *, int);
+static int indexSearch(DiskIndex *, Item *, int, char *);
+static int heavierIn(int32_t *, int, int);
+
+
+// Seven bits at a time, low bits first, the top bit set on every byte but the last
+static void outVarint(OutBuffer *out, uint32_t value) {
+    while (value >= 0x80) {
+        outChar(out, (char) (value | 0x80));
+        value >>= 7;
+    }
+
+    outChar(out, (char) value);
+}
+
+// Reads a varint of at most 31 bits that ends before end; returns -1 if there is none
+static int readVarint(unsigned char **p, unsigned char *end, int *value) {
+    uint32_t read = 0;
+
+    for (int shift = 0; shift < 32 && *p < end; shift += 7) {
+        unsigned char byte = *(*p)++;
+
+        read |= (uint32_t) (byte & 0x7f) << shift;
+
+        if (!(byte & 0x80)) {
+            *value = (int) read;
+            return read <= INT32_MAX ? 0 : -1;
+        }
+    }
+
+    return -1;
+}
+
+static uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t) 7;
+}
+
+// Whether count items of width bytes from an aligned offset end by end, without overflowing
+static int sectionFits(uint64_t offset, uint64_t count, uint64_t width, uint64_t end) {
+    return offset % 8 == 0 && offset <= end && count <= (end - offset) / width;
+}
+
+static int compareTops(const void *a, const void *b) {
+    const IndexTop *x = a;
+    const IndexTop *y = b;
+
+    if (x->low != y->low) return x->low < y->low ? -1 : 1;
+
+    return (x->high > y->high) - (x->high < y->high);
+}
+
+// Copies the top lists of every trie node too wide to rank at query time, sorted by range
+static int collectTops(Trie *trie, IndexTop **tops) {
+    int count = 0;
+
+    *tops = malloc(sizeof(IndexTop) * (trie->nodeCount + 1));
+
+    if (*tops == NULL) return -1;
+
+    for (int i = 0; i < trie->nodeCount; i++) {
+        TrieNode *node = &trie->nodes[i];
+
+        if (node->high - node->low <= INDEX_SCAN_LIMIT) continue;
+
+        (*tops)[count].low = node->low;
+        (*tops)[count].high = node->high;
+        memcpy((*tops)[count].top, node->top, sizeof(node->top));
+        count++;
+    }
+
+    qsort(*tops, count, sizeof(IndexTop), compareTops);
+    return count;
+}
+
+// Writes a section at offset, zero padding up to it from where the file is
+static int writeSection(FILE *fp, void *data, uint64_t size, uint64_t offset) {
+    static const char zeros[8];
+    long at = ftell(fp);
+
+    if (at < 0 || offset - at > sizeof(zeros) || fwrite(zeros, 1, offset - at, fp) != offset - at) return -1;
+
+    return fwrite(data, 1, size, fp) == size ? 0 : -1;
+}
+
+int writeIndex(char *path, Item *dict, int size, Trie *trie) {
+    IndexHeader header;
+    IndexTop *tops;
+    int32_t *weights = malloc(sizeof(int32_t) * (size + 1));
+    uint64_t *buckets = malloc(sizeof(uint64_t) * (size / INDEX_BUCKET + 1));
+    OutBuffer *strings = malloc(sizeof(OutBuffer));
+    int topCount = collectTops(trie, &tops);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.wordCount = size;
+    header.bucketCount = (size + INDEX_BUCKET - 1) / INDEX_BUCKET;
+    header.topCount = topCount;
+
+    if (weights == NULL || buckets == NULL || strings == NULL || topCount < 0) {
+        fprintf(stderr, "Unable to allocate memory for index.\n");
+        free(weights);
+        free(buckets);
+        free(strings);
+        free(tops);
+        return -1;
+    }
+
+    // Front-code the words into memory first, which gives the bucket offsets
+    outInit(strings, OUT_MEMORY);
+
+    for (int i = 0; i < size; i++) {
+        Item *item = &dict[i];
+
+        weights[i] = item->weight;
+
+        if (item->length > header.maxLength) header.maxLength = item->length;
+
+        if (i % INDEX_BUCKET == 0) {
+            // Bytes collected so far, flushed or not
+            buckets[i / INDEX_BUCKET] = strings->spilled + strings->used;
+            outVarint(strings, item->length);
+            outBytes(strings, item->word, item->length);
+            continue;
+        }
+
+        Item *last = &dict[i - 1];
+        int shared = 0;
+
+        while (shared < last->length && shared < item->length && last->word[shared] == item->word[shared]) shared++;
+
+        outVarint(strings, shared);
+        outVarint(strings, item->length - shared);
+        outBytes(strings, item->word + shared, item->length - shared);
+    }
+
+    size_t stringBytes;
+    char *block = outTake(strings, &stringBytes);
+
+    header.weightsOffset = align8(sizeof(IndexHeader));
+    header.bucketsOffset = align8(header.weightsOffset + sizeof(int32_t) * size);
+    header.topsOffset = align8(header.bucketsOffset + sizeof(uint64_t) * header.bucketCount);
+    header.stringsOffset = align8(header.topsOffset + sizeof(IndexTop) * topCount);
+    header.fileSize = header.stringsOffset + stringBytes;
+
+    FILE *fp = block == NULL ? NULL : fopen(path, "wb");
+    int result = -1;
+
+    if (fp != NULL) {
+        result = writeSection(fp, &header, sizeof(header), 0);
+
+        if (result == 0) result = writeSection(fp, weights, sizeof(int32_t) * size, header.weightsOffset);
+        if (result == 0) result = writeSection(fp, buckets, sizeof(uint64_t) * header.bucketCount, header.bucketsOffset);
+        if (result == 0) result = writeSection(fp, tops, sizeof(IndexTop) * topCount, header.topsOffset);
+        if (result == 0) result = writeSection(fp, block, stringBytes, header.stringsOffset);
+        if (fclose(fp) != 0) result = -1;
+    }
+
+    if (result < 0) {
+        fprintf(stderr, "Unable to write index:%s\n", path);
+    }
+
+    free(weights);
+    free(buckets);
+    free(strings);
+    free(tops);
+    free(block);
+    return result;
+}
+
+int openIndex(DiskIndex *index, char *path) {
+    if (mapFile(&index->file, path) < 0) return -1;
+
+    IndexHeader *header = (IndexHeader *) index->file.data;
+    uint64_t size = index->file.size;
+
+    // The sections must all lie inside the file, in order, for a mapping to be trusted,
+    // and no word can be longer than the string block it is decoded from
+    if (size < sizeof(IndexHeader) || memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) != 0
+            || header->fileSize != size || header->wordCount < 0 || header->topCount < 0
+            || header->bucketCount != (header->wordCount + INDEX_BUCKET - 1) / INDEX_BUCKET
+            || header->weightsOffset < sizeof(IndexHeader)
+            || !sectionFits(header->weightsOffset, header->wordCount, sizeof(int32_t), header->bucketsOffset)
+            || !sectionFits(header->bucketsOffset, header->bucketCount, sizeof(uint64_t), header->topsOffset)
+            || !sectionFits(header->topsOffset, header->topCount, sizeof(IndexTop), header->stringsOffset)
+            || !sectionFits(header->stringsOffset, 0, 1, size)
+            || header->maxLength < 0 || (uint64_t) header->maxLength > size - header->stringsOffset) {
+        fprintf(stderr, "Not an index file:%s\n", path);
+        unmapFile(&index->file);
+        return -1;
+    }
+
+    index->header = header;
+    index->weights = (int32_t *) (index->file.data + header->weightsOffset);
+    index->buckets = (uint64_t *) (index->file.data + header->bucketsOffset);
+    index->tops = (IndexTop *) (index->file.data + header->topsOffset);
+    index->strings = (unsigned char *) index->file.data + header->stringsOffset;
+    index->stringsEnd = (unsigned char *) index->file.data + size;
+    return 0;
+}
+
+void closeIndex(DiskIndex *index) {
+    unmapFile(&index->file);
+}
+
+/*
+    Decodes the word stored at p into buffer, which holds the word before it in its bucket
+    unless head is set, and returns the byte after it. Returns NULL if the word would run
+    past the string block or past maxLength, which only a corrupt file's can.
+*/
+static unsigned char *decodeWord(DiskIndex *index, unsigned char *p, int head, char *buffer, int *length) {
+    int shared = 0;
+    int suffix;
+
+    if (!head && (readVarint(&p, index->stringsEnd, &shared) < 0 || shared > *length)) return NULL;
+
+    if (readVarint(&p, index->stringsEnd, &suffix) < 0 || suffix > index->header->maxLength - shared
+            || suffix > index->stringsEnd - p) return NULL;
+
+    memcpy(buffer + shared, p, suffix);
+    *length = shared + suffix;
+    return p + suffix;
+}
+
+// The first byte of a bucket, or NULL if its offset is past the string block
+static unsigned char *bucketStart(DiskIndex *index, int bucket) {
+    uint64_t offset = index->buckets[bucket];
+
+    return offset < (uint64_t) (index->stringsEnd - index->strings) ? index->strings + offset : NULL;
+}
+
+int indexWord(DiskIndex *index, int i, char *buffer) {
+    unsigned char *p = bucketStart(index, i / INDEX_BUCKET);
+    int length = 0;
+
+    for (int j = 0; p != NULL && j <= i % INDEX_BUCKET; j++) {
+        p = decodeWord(index, p, j == 0, buffer, &length);
+    }
+
+    return p != NULL ? length : -1;
+}
+
+/*
+    First word index that sortsBefore no longer holds for: a binary search over the
+    bucket heads, then a scan through the one bucket the answer can be in. Returns -1
+    if a word on the way cannot be decoded.
+*/
+static int indexSearch(DiskIndex *index, Item *query, int end, char *buffer) {
+    int size = index->header->wordCount;
+    int low = 0;
+    int high = index->header->bucketCount;
+    Item word = {buffer, 0, 0};
+
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+
+        if ((word.length = indexWord(index, mid * INDEX_BUCKET, buffer)) < 0) return -1;
+
+        if (sortsBefore(&word, query, end)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == 0) return 0;
+
+    // Every word from the head of the bucket before low on may still sort before
+    int first = (low - 1) * INDEX_BUCKET;
+    int last = first + INDEX_BUCKET < size ? first + INDEX_BUCKET : size;
+    unsigned char *p = bucketStart(index, low - 1);
+
+    if (p == NULL || (p = decodeWord(index, p, 1, buffer, &word.length)) == NULL) return -1;
+
+    for (int i = first + 1; i < last; i++) {
+        if ((p = decodeWord(index, p, 0, buffer, &word.length)) == NULL) return -1;
+
+        if (!sortsBefore(&word, query, end)) return i;
+    }
+
+    return last;
+}
+
+static int heavierIn(int32_t *weights, int a, int b) {
+    if (weights[a] != weights[b]) return weights[a] > weights[b];
+
+    return a < b;
+}
+
+int indexSuggest(DiskIndex *index, char *prefix, int prefixLen, int *top, char *buffer) {
+    Item query = {prefix, prefixLen, 0};
+    int low = indexSearch(index, &query, 0, buffer);
+    int high = indexSearch(index, &query, 1, buffer);
+
+    if (low < 0 || high < 0) return -1;
+
+    if (low >= high) return 0;
+
+    // A narrow range is ranked straight from the weights column
+    if (high - low <= INDEX_SCAN_LIMIT) {
+        int count = 0;
+
+        for (int i = low; i < high; i++) {
+            int j = count < TOP_K ? count++ : TOP_K;
+
+            if (j == TOP_K && !heavierIn(index->weights, i, top[TOP_K - 1])) continue;
+
+            if (j == TOP_K) j--;
+
+            for (; j > 0 && heavierIn(index->weights, i, top[j - 1]); j--) {
+                top[j] = top[j - 1];
+            }
+
+            top[j] = i;
+        }
+
+        return count;
+    }
+
+    IndexTop *tops = index->tops;
+    int first = 0;
+    int last = index->header->topCount - 1;
+
+    while (first <= last) {
+        int mid = first + (last - first) / 2;
+
+        if (tops[mid].low == low && tops[mid].high == high) {
+            // Every word listed has to come from the range
+            for (int j = 0; j < TOP_K; j++) {
+                if (tops[mid].top[j] < low || tops[mid].top[j] >= high) return -1;
+
+                top[j] = tops[mid].top[j];
+            }
+
+            return TOP_K;
+        } else if (tops[mid].low < low || (tops[mid].low == low && tops[mid].high < high)) {
+            first = mid + 1;
+        } else {
+            last = mid - 1;
+        }
+    }
+
+    return 0;
+}
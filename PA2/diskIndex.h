@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include "item.h"
+#include "loader.h"
+#include "trie.h"
+
+#define INDEX_MAGIC "PA2INDX1"
+
+// Words per front-coded bucket; only the first word of a bucket is stored whole
+#define INDEX_BUCKET 16
+
+// Prefix ranges up to this many words are ranked at query time instead of stored
+#define INDEX_SCAN_LIMIT 32
+
+/*
+    The layout of an index file, all in native byte order and every section 8-byte
+    aligned: this header, the weights of the sorted words, the offset of each bucket in
+    the string block, the top-k table, and the string block. In a bucket the first word
+    is stored as a varint length and its bytes, and every later one as a varint count of
+    bytes shared with the word before it, a varint suffix length and the suffix.
+*/
+typedef struct indexHeader{
+    char magic[8];
+    int32_t wordCount;
+    int32_t bucketCount;
+    int32_t topCount;
+    int32_t maxLength;      // longest word, which sizes the decode buffer
+    uint64_t weightsOffset;
+    uint64_t bucketsOffset;
+    uint64_t topsOffset;
+    uint64_t stringsOffset;
+    uint64_t fileSize;
+}IndexHeader;
+
+/*
+    The TOP_K heaviest words of a prefix range holding more than INDEX_SCAN_LIMIT
+    words. Every such range is a trie node's, so no two entries share a range, and the
+    table is sorted by range to be binary searched.
+*/
+typedef struct indexTop{
+    int32_t low;
+    int32_t high;
+    int32_t top[TOP_K];
+}IndexTop;
+
+// An index file mapped for querying; nothing in it is copied or rebuilt
+typedef struct diskIndex{
+    MappedFile file;
+    IndexHeader *header;
+    int32_t *weights;
+    uint64_t *buckets;
+    IndexTop *tops;
+    unsigned char *strings;
+    unsigned char *stringsEnd;
+}DiskIndex;
+
+// Writes the sorted dictionary and its trie to path; returns -1 if it could not
+int writeIndex(char *path, Item *dict, int size, Trie *trie);
+
+/*
+    Maps and checks an index file; returns -1, after reporting it, if it is not one.
+    Only the header is checked up front, so opening stays O(1) however big the file is;
+    the words are bounds-checked as they are decoded.
+*/
+int openIndex(DiskIndex *index, char *path);
+void closeIndex(DiskIndex *index);
+
+/*
+    Decodes word i into buffer, which must hold header->maxLength + 1 bytes, and returns
+    its length, or -1 if the file is corrupt there
+*/
+int indexWord(DiskIndex *index, int i, char *buffer);
+
+/*
+    Fills top with the TOP_K heaviest words starting with prefix, heaviest first and
+    ties broken alphabetically, and returns how many, or -1 if the file is corrupt;
+    buffer is as for indexWord
+*/
+int indexSuggest(DiskIndex *index, char *prefix, int prefixLen, int *top, char *buffer);
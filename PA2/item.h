@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string.h>
+
+// Suggestions printed per query
+#define TOP_K 10
+
+/*
+    A dictionary word and its weight. The word is a view into the mapped input file
+    and is not NUL-terminated, so it always goes together with its length.
+*/
+typedef struct item{
+  char *word;
+  int length;
+  int weight;
+}Item;
+
+// strcmp for word views
+static inline int compareWords(char *a, int aLen, char *b, int bLen) {
+    int result = memcmp(a, b, aLen < bLen ? aLen : bLen);
+
+    if (result != 0) return result;
+
+    return (aLen > bLen) - (aLen < bLen);
+}
+
+// strncmp(target, word, targetLen) for a word view: 0 when the word starts with target
+static inline int comparePrefix(char *target, int targetLen, Item *item) {
+    int result = memcmp(target, item->word, targetLen < item->length ? targetLen : item->length);
+
+    if (result != 0) return result;
+
+    return item->length < targetLen;
+}
+
+// Whether a word sorts before the words starting with query, or with end set, before their end
+static inline int sortsBefore(Item *word, Item *query, int end) {
+    int result = comparePrefix(query->word, query->length, word);
+
+    return end ? result >= 0 : result > 0;
+}
+
+// Ranks dictionary indices: heavier weight first, the alphabetically earlier word on a tie
+static inline int heavier(Item *dict, int a, int b) {
+    if (dict[a].weight != dict[b].weight) return dict[a].weight > dict[b].weight;
+
+    return a < b;
+}
@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "loader.h"
+
+// Items parsed so far, grown by doubling since the line count is not known up front
+typedef struct itemList{
+    Item *items;
+    int count;
+    int capacity;
+}ItemList;
+
+static int isBlank(char);
+static Item *newItem(ItemList *);
+static int addLine(ItemList *, char *, char *);
+static int addWholeLine(ItemList *, char *, char *);
+static int splitLines(ItemList *, char *, char *, int (*)(ItemList *, char *, char *));
+static int loadWith(MappedFile *, Item **, int (*)(ItemList *, char *, char *));
+
+
+int mapFile(MappedFile *file, char *path) {
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+
+    if (fd < 0 || fstat(fd, &info) < 0) {
+        fprintf(stderr, "Error opening file:%s\n", path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+
+    file->data = NULL;
+    file->size = info.st_size;
+
+    // An empty file cannot be mapped, and has no lines anyway
+    if (file->size > 0) {
+        file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (file->data == MAP_FAILED) {
+            fprintf(stderr, "Unable to map file:%s\n", path);
+            close(fd);
+            return -1;
+        }
+    }
+
+    // The mapping stays valid once the descriptor is closed
+    close(fd);
+    return 0;
+}
+
+void unmapFile(MappedFile *file) {
+    if (file->data != NULL) munmap(file->data, file->size);
+
+    file->data = NULL;
+    file->size = 0;
+}
+
+// The separators fscanf's %s stops at, short of the newline itself
+static int isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+int readToken(Item *line, int from, Item *token) {
+    char *p = line->word + from;
+    char *end = line->word + line->length;
+
+    while (p < end && isBlank(*p)) p++;
+
+    token->word = p;
+
+    while (p < end && !isBlank(*p)) p++;
+
+    token->length = p - token->word;
+    token->weight = 0;
+    return token->length > 0 ? p - line->word : -1;
+}
+
+int parseWeight(Item *token) {
+    char *p = token->word;
+    char *end = p + token->length;
+    int negative = p < end && *p == '-';
+
+    if (p < end && (*p == '-' || *p == '+')) p++;
+
+    unsigned int weight = 0;
+
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        weight = weight * 10 + (*p - '0');
+    }
+
+    return negative ? -weight : weight;
+}
+
+// Appends an item to fill in, or returns NULL if the list cannot grow
+static Item *newItem(ItemList *list) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity == 0 ? 1024 : list->capacity * 2;
+        Item *items = realloc(list->items, sizeof(Item) * capacity);
+
+        if (items == NULL) return NULL;
+
+        list->items = items;
+        list->capacity = capacity;
+    }
+
+    return &list->items[list->count++];
+}
+
+// Parses the line [start, end) into the next item, skipping it if it is blank
+static int addLine(ItemList *list, char *start, char *end) {
+    Item line = {start, end - start, 0};
+    Item word;
+    Item weight;
+    int at = readToken(&line, 0, &word);
+
+    if (at < 0) return 0;
+
+    Item *item = newItem(list);
+
+    if (item == NULL) return -1;
+
+    readToken(&line, at, &weight);
+    *item = word;
+    item->weight = parseWeight(&weight);
+    return 0;
+}
+
+// Keeps the line [start, end) whole, from its first token on, skipping it if it is blank
+static int addWholeLine(ItemList *list, char *start, char *end) {
+    while (start < end && isBlank(*start)) start++;
+
+    if (start == end) return 0;
+
+    Item *item = newItem(list);
+
+    if (item == NULL) return -1;
+
+    item->word = start;
+    item->length = end - start;
+    item->weight = 0;
+    return 0;
+}
+
+// Hands every line of [p, end) to add in order; returns -1 if one could not be stored
+static int splitLines(ItemList *list, char *p, char *end, int (*add)(ItemList *, char *, char *)) {
+    char *line = p;
+
+#ifdef __SSE2__
+    // Sixteen bytes at a time, turning the newlines in each block into a bit mask and
+    // handing every line that ends inside it to the parser
+    __m128i newline = _mm_set1_epi8('\n');
+
+    for (; end - p >= 16; p += 16) {
+        unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i *) p), newline));
+
+        while (mask != 0) {
+            char *lineEnd = p + __builtin_ctz(mask);
+
+            if (add(list, line, lineEnd) < 0) return -1;
+
+            line = lineEnd + 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; p < end; p++) {
+        if (*p == '\n') {
+            if (add(list, line, p) < 0) return -1;
+
+            line = p + 1;
+        }
+    }
+
+    // The last line need not end in a newline
+    return add(list, line, end);
+}
+
+static int loadWith(MappedFile *file, Item **items, int (*add)(ItemList *, char *, char *)) {
+    ItemList list = {NULL, 0, 0};
+
+    if (file->size > 0 && splitLines(&list, file->data, file->data + file->size, add) < 0) {
+        fprintf(stderr, "Unable to allocate memory for %d items.\n", list.capacity * 2);
+        free(list.items);
+        return -1;
+    }
+
+    *items = list.items;
+    return list.count;
+}
+
+int loadItems(MappedFile *file, Item **items) {
+    return loadWith(file, items, addLine);
+}
+
+int loadLines(MappedFile *file, Item **lines) {
+    return loadWith(file, lines, addWholeLine);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include "item.h"
+
+// A whole input file mapped read-only into memory
+typedef struct mappedFile{
+    char *data;
+    size_t size;
+}MappedFile;
+
+// Returns -1, after reporting it, if the file cannot be opened or mapped
+int mapFile(MappedFile *file, char *path);
+
+// Unmapping the file invalidates every word loaded from it
+void unmapFile(MappedFile *file);
+
+/*
+    Parses a mapped file in one pass, one Item per non-blank line: the line's first
+    whitespace-separated token is the word, viewed in place, and the integer after it,
+    if there is one, the weight. Query files simply have no weights. Stores a malloc'd
+    array in *items and returns how many lines it held, or -1.
+*/
+int loadItems(MappedFile *file, Item **items);
+
+// loadItems without the parsing: every non-blank line whole, from its first token on
+int loadLines(MappedFile *file, Item **lines);
+
+/*
+    Reads the whitespace-separated token of a line starting at or after byte from into
+    token; returns where it ends, or -1, leaving token empty, if the line has no more
+*/
+int readToken(Item *line, int from, Item *token);
+
+// The optionally signed integer a token starts with, 0 if it has none
+int parseWeight(Item *token);
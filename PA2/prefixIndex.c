@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "prefixIndex.h"
+
+// Bytes in a cache line, which holds 8 keys
+#define LINE_SIZE 64
+
+static uint64_t prefixKey(char *, int, unsigned char);
+static int fillIndex(PrefixIndex *, int, int);
+static int descend(PrefixIndex *, char *, int, int);
+
+
+// The first 8 bytes of a word as a big-endian integer, any past its end taken as pad
+static uint64_t prefixKey(char *word, int length, unsigned char pad) {
+    uint64_t key = 0;
+
+    for (int i = 0; i < 8; i++) {
+        key = key << 8 | (i < length ? (unsigned char) word[i] : pad);
+    }
+
+    return key;
+}
+
+// Fills node k's subtree by an in-order walk, starting at dictionary index next
+static int fillIndex(PrefixIndex *index, int next, int k) {
+    if (k > index->size) return next;
+
+    next = fillIndex(index, next, 2 * k);
+
+    Item *item = &index->dict[next];
+    index->keys[k] = prefixKey(item->word, item->length, 0);
+    index->rank[k] = next;
+
+    return fillIndex(index, next + 1, 2 * k + 1);
+}
+
+PrefixIndex *buildPrefixIndex(Item *dict, int size) {
+    PrefixIndex *index = malloc(sizeof(PrefixIndex));
+
+    if (index == NULL) {
+        fprintf(stderr, "Unable to allocate memory for prefix index.\n");
+        return NULL;
+    }
+
+    // Aligned so that the keys 8k to 8k + 7, node k's descendants three levels down,
+    // share one cache line
+    size_t keyBytes = (sizeof(uint64_t) * (size + 1) + LINE_SIZE - 1) / LINE_SIZE * LINE_SIZE;
+
+    index->dict = dict;
+    index->size = size;
+    index->keys = aligned_alloc(LINE_SIZE, keyBytes);
+    index->rank = malloc(sizeof(int) * (size + 1));
+
+    if (index->keys == NULL || index->rank == NULL) {
+        fprintf(stderr, "Unable to allocate memory for prefix index.\n");
+        freePrefixIndex(index);
+        return NULL;
+    }
+
+    fillIndex(index, 0, 1);
+    return index;
+}
+
+void freePrefixIndex(PrefixIndex *index) {
+    if (index == NULL) return;
+
+    free(index->keys);
+    free(index->rank);
+    free(index);
+}
+
+/*
+    First dictionary index whose word does not sort before target, or with end set,
+    before the end of the words starting with target. Each step goes left or right
+    without a branch; only a tie on the 8-byte key compares the words themselves. For
+    the end of a short target, padding its key with 0xff bytes makes the key alone
+    decide: every word starting with target has a key at most that.
+*/
+static int descend(PrefixIndex *index, char *target, int targetLen, int end) {
+    uint64_t key = prefixKey(target, targetLen, end && targetLen < 8 ? 0xff : 0);
+    uint64_t *keys = index->keys;
+    int k = 1;
+
+    while (k <= index->size) {
+        __builtin_prefetch(keys + 8 * k);
+
+        int before = keys[k] < key;
+
+        if (keys[k] == key) {
+            int result = comparePrefix(target, targetLen, &index->dict[index->rank[k]]);
+            before = end ? result >= 0 : result > 0;
+        }
+
+        k = 2 * k + before;
+    }
+
+    // Undo the final run of right turns, and the left turn before it, to reach the answer
+    k >>= __builtin_ffs(~k);
+
+    return k == 0 ? index->size : index->rank[k];
+}
+
+int prefixIndexFind(PrefixIndex *index, char *target, int targetLen) {
+    int low = descend(index, target, targetLen, 0);
+
+    if (low == index->size || comparePrefix(target, targetLen, &index->dict[low]) != 0) return -1;
+
+    return low;
+}
+
+int prefixIndexEnd(PrefixIndex *index, char *target, int targetLen) {
+    return descend(index, target, targetLen, 1);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include "item.h"
+
+/*
+    A search index over the alphabetically sorted dictionary. The first 8 bytes of each
+    word, zero padded and read as a big-endian integer, are stored in Eytzinger order:
+    the tree of a binary search laid out breadth first, node k having children 2k and
+    2k + 1. A search then walks down one array, touching cache lines the prefetcher
+    has already asked for, and compares whole words only when 8-byte keys tie.
+*/
+typedef struct prefixIndex{
+    Item *dict;
+    int size;
+    uint64_t *keys;     // keys[1..size], keys[0] unused
+    int *rank;          // dictionary index of the word behind each key
+}PrefixIndex;
+
+// The dictionary must already be sorted by word, and must outlive the index
+PrefixIndex *buildPrefixIndex(Item *dict, int size);
+void freePrefixIndex(PrefixIndex *index);
+
+// The same as binSearchItems: the leftmost word starting with target, or -1
+int prefixIndexFind(PrefixIndex *index, char *target, int targetLen);
+
+// One past the last word starting with target
+int prefixIndexEnd(PrefixIndex *index, char *target, int targetLen);
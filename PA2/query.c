@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "query.h"
+#include "loader.h"
+#include "wordSort.h"
+
+// One chunk's formatted output, waiting for its turn to be written
+typedef struct chunkResult{
+    char *text;
+    size_t length;
+    int done;
+}ChunkResult;
+
+// State shared by the workers and the thread writing their output
+typedef struct queryPool{
+    Suggester *suggester;
+    Item *queries;
+    int queryCount;
+    int chunkCount;
+    int nextChunk;      // next chunk a worker may claim
+    int written;        // chunks already handed to the output
+    int window;         // how far past written a worker may claim
+    ChunkResult *results;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+}QueryPool;
+
+// Cache misses are formatted here before being kept; only the serial drivers have a cache
+static OutBuffer block;
+
+static void *queryWorker(void *);
+static int gallop(Item *, int, int, Item *, int);
+static int printIndexMatches(OutBuffer *, DiskIndex *, char *, int, int *, int, char *);
+static int isKeyword(Item *, char *);
+static void forgetWord(ResultCache *, Suggester *, char *, int);
+
+
+int printSuggestions(OutBuffer *out, Suggester *suggester, char *query, int queryLen) {
+    int top[TOP_K];
+    int scanned;
+    int matchCount = suggestScanned(suggester, query, queryLen, top, &scanned);
+
+    printMatches(out, suggester, query, queryLen, top, matchCount);
+    return scanned;
+}
+
+void printMatches(OutBuffer *out, Suggester *suggester, char *query, int queryLen, int *top, int matchCount) {
+    outText(out, "Query word:");
+    outBytes(out, query, queryLen);
+    outChar(out, '\n');
+    if (matchCount == 0) {
+        outText(out, "No suggestion!\n");
+        return;
+    }
+
+    // Heaviest first, ties broken alphabetically
+    for(int j = 0; j < matchCount; j++){
+        Item *match = &suggester->dict[top[j]];
+        outBytes(out, match->word, match->length);
+        outChar(out, ' ');
+        outInt(out, match->weight);
+        outChar(out, '\n');
+    }
+}
+
+int printCached(OutBuffer *out, Suggester *suggester, ResultCache *cache, char *query, int queryLen) {
+    size_t length;
+    char *text = cache == NULL ? NULL : cacheFind(cache, query, queryLen, &length);
+
+    if (text != NULL) {
+        outBytes(out, text, length);
+        return 0;
+    }
+
+    if (cache == NULL) return printSuggestions(out, suggester, query, queryLen);
+
+    outInit(&block, OUT_MEMORY);
+
+    int scanned = printSuggestions(&block, suggester, query, queryLen);
+
+    if ((text = outTake(&block, &length)) == NULL) {
+        // Out of memory for the copy; the answer can still go out directly
+        return printSuggestions(out, suggester, query, queryLen);
+    }
+
+    outBytes(out, text, length);
+    cacheStore(cache, query, queryLen, text, length);
+    free(text);
+    return scanned;
+}
+
+void procQueries(OutBuffer *out, Suggester *suggester, ResultCache *cache, QueryStats *stats, Item *queries, int queryCount) {
+    for (int i = 0; i < queryCount; i++) {
+        long long start = stats != NULL ? statsClock() : 0;
+        int scanned = printCached(out, suggester, cache, queries[i].word, queries[i].length);
+
+        if (stats != NULL) statsRecord(stats, queries[i].word, queries[i].length, statsClock() - start, scanned);
+    }
+}
+
+static void *queryWorker(void *arg) {
+    QueryPool *pool = arg;
+    OutBuffer *local = malloc(sizeof(OutBuffer));
+
+    if (local != NULL) outInit(local, OUT_MEMORY);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (1) {
+        // Waiting here keeps finished but unwritten output from piling up
+        while (pool->nextChunk < pool->chunkCount && pool->nextChunk >= pool->written + pool->window) {
+            pthread_cond_wait(&pool->changed, &pool->lock);
+        }
+
+        if (pool->nextChunk == pool->chunkCount) break;
+
+        int chunk = pool->nextChunk++;
+        int first = chunk * QUERY_CHUNK;
+        int count = pool->queryCount - first < QUERY_CHUNK ? pool->queryCount - first : QUERY_CHUNK;
+        char *text = NULL;
+        size_t length = 0;
+
+        pthread_mutex_unlock(&pool->lock);
+
+        // A NULL text tells the writer this chunk was lost
+        if (local != NULL) {
+            procQueries(local, pool->suggester, NULL, NULL, pool->queries + first, count);
+            text = outTake(local, &length);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        pool->results[chunk].text = text;
+        pool->results[chunk].length = length;
+        pool->results[chunk].done = 1;
+        pthread_cond_broadcast(&pool->changed);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    free(local);
+    return NULL;
+}
+
+int procQueriesParallel(OutBuffer *out, Suggester *suggester, Item *queries, int queryCount, int threadCount) {
+    QueryPool pool;
+    pool.suggester = suggester;
+    pool.queries = queries;
+    pool.queryCount = queryCount;
+    pool.chunkCount = (queryCount + QUERY_CHUNK - 1) / QUERY_CHUNK;
+    pool.nextChunk = 0;
+    pool.written = 0;
+    pool.window = threadCount * CHUNKS_AHEAD;
+    pool.results = calloc(pool.chunkCount + 1, sizeof(ChunkResult));
+
+    pthread_t *threads = malloc(sizeof(pthread_t) * threadCount);
+
+    if (pool.results == NULL || threads == NULL) {
+        fprintf(stderr, "Unable to allocate memory for query threads.\n");
+        free(pool.results);
+        free(threads);
+        return -1;
+    }
+
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.changed, NULL);
+
+    int started = 0;
+
+    for (; started < threadCount; started++) {
+        if (pthread_create(&threads[started], NULL, queryWorker, &pool) != 0) break;
+    }
+
+    int result = 0;
+
+    // Without a single worker, the chunks are answered right here instead
+    if (started == 0) {
+        procQueries(out, suggester, NULL, NULL, queries, queryCount);
+        pool.written = pool.chunkCount;
+    }
+
+    // Write the chunks out in order as they finish, freeing each one
+    while (pool.written < pool.chunkCount) {
+        ChunkResult *chunk = &pool.results[pool.written];
+
+        pthread_mutex_lock(&pool.lock);
+
+        while (!chunk->done) {
+            pthread_cond_wait(&pool.changed, &pool.lock);
+        }
+
+        pthread_mutex_unlock(&pool.lock);
+
+        if (chunk->text == NULL) {
+            result = -1;
+        } else {
+            outBytes(out, chunk->text, chunk->length);
+            free(chunk->text);
+        }
+
+        pthread_mutex_lock(&pool.lock);
+        pool.written++;
+        pthread_cond_broadcast(&pool.changed);
+        pthread_mutex_unlock(&pool.lock);
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (result < 0) {
+        fprintf(stderr, "Unable to allocate memory for query output.\n");
+    }
+
+    pthread_mutex_destroy(&pool.lock);
+    pthread_cond_destroy(&pool.changed);
+    free(pool.results);
+    free(threads);
+    return result;
+}
+
+/*
+    First index in [from, limit) that sortsBefore no longer holds for, or limit. Probes
+    from, from + 1, from + 3, from + 7 and so on before binary searching the last gap,
+    so a nearby answer costs only a few compares.
+*/
+static int gallop(Item *dict, int from, int limit, Item *query, int end) {
+    int low = from;
+    int high = from;
+    int step = 1;
+
+    while (high < limit && sortsBefore(&dict[high], query, end)) {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+
+    if (high > limit) high = limit;
+
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+
+        if (sortsBefore(&dict[mid], query, end)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+int procQueriesBatch(OutBuffer *out, Suggester *suggester, Item *queries, int queryCount) {
+    Item *sorted = malloc(sizeof(Item) * (queryCount + 1));
+    int *results = malloc(sizeof(int) * (TOP_K + 1) * (queryCount + 1));
+
+    if (sorted == NULL || results == NULL) {
+        fprintf(stderr, "Unable to allocate memory for batched queries.\n");
+        free(sorted);
+        free(results);
+        return -1;
+    }
+
+    // Queries carry no weight, so that slot remembers where each one came from
+    for (int i = 0; i < queryCount; i++) {
+        sorted[i] = queries[i];
+        sorted[i].weight = i;
+    }
+
+    multikeySort(sorted, queryCount);
+
+    Item *dict = suggester->dict;
+    int *previous = NULL;
+    int low = 0;
+    int high = 0;
+
+    // Each result is its match count followed by up to TOP_K dictionary indices
+    for (int i = 0; i < queryCount; i++) {
+        Item *query = &sorted[i];
+        int *result = results + query->weight * (TOP_K + 1);
+        Item *last = i > 0 ? &sorted[i - 1] : NULL;
+
+        if (last != NULL && last->length <= query->length && memcmp(last->word, query->word, last->length) == 0) {
+            // A repeated query has the same answer
+            if (last->length == query->length) {
+                memcpy(result, previous, sizeof(int) * (TOP_K + 1));
+                continue;
+            }
+
+            // Extending the previous query narrows its range, so only that range is searched
+            low = gallop(dict, low, high, query, 0);
+            high = gallop(dict, low, high, query, 1);
+        } else {
+            // Range starts only move forward as the queries increase
+            low = gallop(dict, low, suggester->dictSize, query, 0);
+            high = gallop(dict, low, suggester->dictSize, query, 1);
+        }
+
+        result[0] = low < high ? rangeTopK(suggester->range, low, high, result + 1, NULL) : 0;
+        previous = result;
+    }
+
+    // Scatter the answers back out in the order the queries were asked
+    for (int i = 0; i < queryCount; i++) {
+        int *result = results + i * (TOP_K + 1);
+        printMatches(out, suggester, queries[i].word, queries[i].length, result + 1, result[0]);
+    }
+
+    free(sorted);
+    free(results);
+    return 0;
+}
+
+// printMatches for words that have to be decoded out of an index file first; returns -1 if one cannot be
+static int printIndexMatches(OutBuffer *out, DiskIndex *index, char *query, int queryLen, int *top, int matchCount, char *buffer) {
+    outText(out, "Query word:");
+    outBytes(out, query, queryLen);
+    outChar(out, '\n');
+    if (matchCount == 0) {
+        outText(out, "No suggestion!\n");
+        return 0;
+    }
+
+    for(int j = 0; j < matchCount; j++){
+        int length = indexWord(index, top[j], buffer);
+
+        if (length < 0) return -1;
+
+        outBytes(out, buffer, length);
+        outChar(out, ' ');
+        outInt(out, index->weights[top[j]]);
+        outChar(out, '\n');
+    }
+
+    return 0;
+}
+
+int procIndexQueries(OutBuffer *out, DiskIndex *index, Item *queries, int queryCount) {
+    char *buffer = malloc(index->header->maxLength + 1);
+
+    if (buffer == NULL) {
+        fprintf(stderr, "Unable to allocate memory for index queries.\n");
+        return -1;
+    }
+
+    for (int i = 0; i < queryCount; i++) {
+        int top[TOP_K];
+        int matchCount = indexSuggest(index, queries[i].word, queries[i].length, top, buffer);
+
+        if (matchCount < 0 || printIndexMatches(out, index, queries[i].word, queries[i].length, top, matchCount, buffer) < 0) {
+            fprintf(stderr, "The index file is corrupt.\n");
+            free(buffer);
+            return -1;
+        }
+    }
+
+    free(buffer);
+    return 0;
+}
+
+static int isKeyword(Item *token, char *keyword) {
+    return token->length == (int) strlen(keyword) && memcmp(token->word, keyword, token->length) == 0;
+}
+
+int parseOperations(Item *lines, int lineCount, Operation **ops) {
+    *ops = malloc(sizeof(Operation) * (lineCount + 1));
+
+    if (*ops == NULL) {
+        fprintf(stderr, "Unable to allocate memory for %d operations.\n", lineCount);
+        return -1;
+    }
+
+    for (int i = 0; i < lineCount; i++) {
+        Operation *op = &(*ops)[i];
+        Item command;
+        Item weight;
+        int at = readToken(&lines[i], 0, &command);
+        int next = readToken(&lines[i], at, &op->item);
+        int hasWeight = next >= 0 && readToken(&lines[i], next, &weight) >= 0;
+
+        if (hasWeight && isKeyword(&command, "insert")) {
+            op->kind = OP_INSERT;
+        } else if (hasWeight && isKeyword(&command, "update")) {
+            op->kind = OP_UPDATE;
+        } else if (next >= 0 && isKeyword(&command, "delete")) {
+            op->kind = OP_DELETE;
+        } else {
+            op->kind = OP_QUERY;
+            op->item = command;
+        }
+
+        op->item.weight = hasWeight ? parseWeight(&weight) : 0;
+    }
+
+    return lineCount;
+}
+
+/*
+    Drops the cached answers a change to word may have altered: those for its prefixes,
+    or with fuzzy queries, which any nearby prefix may reach, all of them
+*/
+static void forgetWord(ResultCache *cache, Suggester *suggester, char *word, int length) {
+    if (cache == NULL) return;
+
+    if (suggester->maxEdits > 0) {
+        cacheClear(cache);
+        return;
+    }
+
+    for (int i = 1; i <= length; i++) {
+        cacheForget(cache, word, i);
+    }
+}
+
+int procOperations(OutBuffer *out, Suggester *suggester, ResultCache *cache, QueryStats *stats, Operation *ops, int opCount) {
+    for (int i = 0; i < opCount; i++) {
+        Item *item = &ops[i].item;
+        int result = 0;
+
+        if (ops[i].kind == OP_QUERY) {
+            procQueries(out, suggester, cache, stats, item, 1);
+            continue;
+        }
+
+        if (ops[i].kind == OP_INSERT) {
+            result = insertWord(suggester, item->word, item->length, item->weight);
+        } else if (ops[i].kind == OP_UPDATE) {
+            result = updateWord(suggester, item->word, item->length, item->weight);
+        } else {
+            result = deleteWord(suggester, item->word, item->length);
+        }
+
+        if (result < 0) return -1;
+
+        if (result == 0) forgetWord(cache, suggester, item->word, item->length);
+
+        if (result > 0) {
+            fprintf(stderr, "%s:%.*s\n", ops[i].kind == OP_INSERT ? "Already in the dictionary" : "Not in the dictionary",
+                    item->length, item->word);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "outBuffer.h"
+#include "item.h"
+#include "suggest.h"
+#include "diskIndex.h"
+#include "resultCache.h"
+#include "stats.h"
+
+// What a line of a live query file asks for
+#define OP_QUERY 0
+#define OP_INSERT 1
+#define OP_UPDATE 2
+#define OP_DELETE 3
+
+// Queries a thread answers at a time in the parallel mode
+#define QUERY_CHUNK 512
+
+// Finished chunks each thread may get ahead of the output before it waits
+#define CHUNKS_AHEAD 4
+
+// One line of a live query file: the query, or the word and weight to change
+typedef struct operation{
+    int kind;
+    Item item;
+}Operation;
+
+// Writes the "Query word:" block for one query; returns the dictionary entries scanned for it
+int printSuggestions(OutBuffer *out, Suggester *suggester, char *query, int queryLen);
+
+// Writes the block for a query whose matches, as from suggest, are already known
+void printMatches(OutBuffer *out, Suggester *suggester, char *query, int queryLen, int *top, int matchCount);
+
+/*
+    printSuggestions through a cache, which may be NULL: a repeated query is answered
+    by copying out its block, scanning nothing, and a new one is formatted aside first
+    to be kept
+*/
+int printCached(OutBuffer *out, Suggester *suggester, ResultCache *cache, char *query, int queryLen);
+
+// Answers the queries in order; stats, if not NULL, records each one's latency
+void procQueries(OutBuffer *out, Suggester *suggester, ResultCache *cache, QueryStats *stats, Item *queries, int queryCount);
+
+/*
+    Answers the queries on threadCount threads. Every chunk of QUERY_CHUNK queries is
+    formatted into its own block of memory, and the blocks are written to out in query
+    order, so the output is byte for byte the same as procQueries. Returns -1 if the
+    threads or their output could not be allocated.
+*/
+int procQueriesParallel(OutBuffer *out, Suggester *suggester, Item *queries, int queryCount, int threadCount);
+
+/*
+    Answers the queries in one merge pass: sorted, they are walked alongside the sorted
+    dictionary, each range found by galloping forward from the last one, and a query
+    that extends the previous one searches only inside its range. The answers are then
+    printed in the original query order. Needs the suggester's range index.
+*/
+int procQueriesBatch(OutBuffer *out, Suggester *suggester, Item *queries, int queryCount);
+
+// procQueries against an index file written by writeIndex
+int procIndexQueries(OutBuffer *out, DiskIndex *index, Item *queries, int queryCount);
+
+/*
+    Reads the lines of a live query file, as from loadLines: "insert word weight",
+    "update word weight" and "delete word" change the dictionary, and any other line is
+    a query on its first token, just as in a plain query file. Stores a malloc'd array
+    in *ops and returns how many lines there were, or -1.
+*/
+int parseOperations(Item *lines, int lineCount, Operation **ops);
+
+/*
+    Runs the operations in file order, so every query sees exactly the updates above it;
+    each update drops the cached answers it may change. An update that does not apply,
+    such as inserting a word already there, is reported and skipped. Returns -1 if
+    memory ran out or the suggester cannot be updated.
+*/
+int procOperations(OutBuffer *out, Suggester *suggester, ResultCache *cache, QueryStats *stats, Operation *ops, int opCount);
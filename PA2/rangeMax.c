@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "rangeMax.h"
+
+// A range waiting in rangeTopK's queue, keyed by the heaviest word inside it
+typedef struct span{
+    int low;
+    int high;
+    int best;
+}Span;
+
+static int floorLog2(int);
+static int pushSpan(RangeMax *, Span *, int *, int, int);
+static Span popSpan(RangeMax *, Span *, int *);
+
+
+static int floorLog2(int n) {
+    int log = 0;
+
+    while (n >>= 1) log++;
+
+    return log;
+}
+
+RangeMax *buildRangeMax(Item *dict, int size) {
+    RangeMax *range = malloc(sizeof(RangeMax));
+
+    if (range == NULL) {
+        fprintf(stderr, "Unable to allocate memory for range index.\n");
+        return NULL;
+    }
+
+    range->dict = dict;
+    range->size = size;
+    range->levels = size > 0 ? floorLog2(size) + 1 : 0;
+    range->table = malloc(sizeof(int) * size * range->levels);
+
+    if (size > 0 && range->table == NULL) {
+        fprintf(stderr, "Unable to allocate memory for range index.\n");
+        free(range);
+        return NULL;
+    }
+
+    for (int i = 0; i < size; i++) {
+        range->table[i] = i;
+    }
+
+    // Each row pairs up two windows of the row below it
+    for (int k = 1; k < range->levels; k++) {
+        int *row = range->table + k * size;
+        int *below = row - size;
+        int half = 1 << (k - 1);
+
+        for (int i = 0; i + (1 << k) <= size; i++) {
+            int a = below[i];
+            int b = below[i + half];
+            row[i] = heavier(dict, a, b) ? a : b;
+        }
+    }
+
+    return range;
+}
+
+void freeRangeMax(RangeMax *range) {
+    if (range == NULL) return;
+
+    free(range->table);
+    free(range);
+}
+
+int rangeMaxAt(RangeMax *range, int low, int high) {
+    int k = floorLog2(high - low);
+    int *row = range->table + k * range->size;
+    int a = row[low];
+    int b = row[high - (1 << k)];
+
+    return heavier(range->dict, a, b) ? a : b;
+}
+
+// Adds [low, high) to the max-heap of spans unless it is empty; returns whether it did
+static int pushSpan(RangeMax *range, Span *heap, int *count, int low, int high) {
+    if (low >= high) return 0;
+
+    Span span = {low, high, rangeMaxAt(range, low, high)};
+    int i = (*count)++;
+
+    while (i > 0 && heavier(range->dict, span.best, heap[(i - 1) / 2].best)) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    heap[i] = span;
+    return 1;
+}
+
+static Span popSpan(RangeMax *range, Span *heap, int *count) {
+    Span top = heap[0];
+    Span last = heap[--(*count)];
+    int i = 0;
+
+    while (2 * i + 1 < *count) {
+        int child = 2 * i + 1;
+
+        if (child + 1 < *count && heavier(range->dict, heap[child + 1].best, heap[child].best)) child++;
+
+        if (!heavier(range->dict, heap[child].best, last.best)) break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = last;
+    return top;
+}
+
+int rangeTopK(RangeMax *range, int low, int high, int *top, int *scanned) {
+    // Every pop takes one span and gives back at most two, so the heap stays small
+    Span heap[2 * TOP_K + 1];
+    int count = 0;
+    int found = 0;
+    int probes = pushSpan(range, heap, &count, low, high);
+
+    while (found < TOP_K && count > 0) {
+        Span span = popSpan(range, heap, &count);
+
+        top[found++] = span.best;
+        probes += pushSpan(range, heap, &count, span.low, span.best);
+        probes += pushSpan(range, heap, &count, span.best + 1, span.high);
+    }
+
+    if (scanned != NULL) *scanned = probes;
+
+    return found;
+}
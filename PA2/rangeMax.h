@@ -0,0 +1,29 @@
+#pragma once
+
+#include "item.h"
+
+/*
+    A sparse table over the weights of the alphabetically sorted dictionary. Row k holds,
+    for every i, the index of the heaviest word in [i, i + 2^k), so the heaviest word of
+    any range is the better of two overlapping rows. It costs n log n ints and no copy
+    of the dictionary.
+*/
+typedef struct rangeMax{
+    Item *dict;
+    int size;
+    int levels;
+    int *table;         // levels rows of size ints, row k at table + k * size
+}RangeMax;
+
+// The dictionary must already be sorted by word, and must outlive the table
+RangeMax *buildRangeMax(Item *dict, int size);
+void freeRangeMax(RangeMax *range);
+
+// Index of the heaviest word in [low, high), which must not be empty
+int rangeMaxAt(RangeMax *range, int low, int high);
+
+/*
+    Fills top with the TOP_K heaviest words of [low, high), heaviest first, and returns
+    how many it found; scanned, if not NULL, gets how many sub-ranges it probed
+*/
+int rangeTopK(RangeMax *range, int low, int high, int *top, int *scanned);
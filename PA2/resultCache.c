@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "resultCache.h"
+
+static void resetCache(ResultCache *);
+static unsigned int hashKey(char *, int);
+static int *findSlot(ResultCache *, char *, int);
+static void unlinkEntry(ResultCache *, int);
+static void pushNewest(ResultCache *, int);
+static void dropEntry(ResultCache *, int *);
+
+
+// Empties every bucket and puts every entry on the free list
+static void resetCache(ResultCache *cache) {
+    for (int i = 0; i <= cache->bucketMask; i++) {
+        cache->buckets[i] = -1;
+    }
+
+    for (int i = 0; i < cache->capacity; i++) {
+        cache->entries[i].chain = i + 1 < cache->capacity ? i + 1 : -1;
+    }
+
+    cache->newest = -1;
+    cache->oldest = -1;
+    cache->unused = 0;
+}
+
+ResultCache *buildCache(int capacity) {
+    ResultCache *cache = malloc(sizeof(ResultCache));
+
+    if (cache == NULL) {
+        fprintf(stderr, "Unable to allocate memory for result cache.\n");
+        return NULL;
+    }
+
+    // At least two buckets an entry keeps the chains short
+    int bucketCount = 1;
+
+    while (bucketCount < 2 * capacity) bucketCount *= 2;
+
+    cache->entries = malloc(sizeof(CacheEntry) * capacity);
+    cache->capacity = capacity;
+    cache->buckets = malloc(sizeof(int) * bucketCount);
+    cache->bucketMask = bucketCount - 1;
+    cache->hits = 0;
+    cache->misses = 0;
+
+    if (cache->entries == NULL || cache->buckets == NULL) {
+        fprintf(stderr, "Unable to allocate memory for result cache.\n");
+        free(cache->entries);
+        free(cache->buckets);
+        free(cache);
+        return NULL;
+    }
+
+    resetCache(cache);
+    return cache;
+}
+
+void freeCache(ResultCache *cache) {
+    if (cache == NULL) return;
+
+    cacheClear(cache);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
+// FNV-1a
+static unsigned int hashKey(char *key, int keyLen) {
+    unsigned int hash = 2166136261u;
+
+    for (int i = 0; i < keyLen; i++) {
+        hash = (hash ^ (unsigned char) key[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+// The link holding key's entry, or the -1 that ends its bucket's chain if it has none
+static int *findSlot(ResultCache *cache, char *key, int keyLen) {
+    int *slot = &cache->buckets[hashKey(key, keyLen) & cache->bucketMask];
+
+    while (*slot != -1) {
+        CacheEntry *entry = &cache->entries[*slot];
+
+        if (entry->keyLen == keyLen && memcmp(entry->key, key, keyLen) == 0) break;
+
+        slot = &entry->chain;
+    }
+
+    return slot;
+}
+
+static void unlinkEntry(ResultCache *cache, int i) {
+    CacheEntry *entry = &cache->entries[i];
+
+    if (entry->newer != -1) {
+        cache->entries[entry->newer].older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+
+    if (entry->older != -1) {
+        cache->entries[entry->older].newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+}
+
+static void pushNewest(ResultCache *cache, int i) {
+    CacheEntry *entry = &cache->entries[i];
+
+    entry->newer = -1;
+    entry->older = cache->newest;
+
+    if (cache->newest != -1) {
+        cache->entries[cache->newest].newer = i;
+    } else {
+        cache->oldest = i;
+    }
+
+    cache->newest = i;
+}
+
+// Removes the entry slot links to from its chain and the recency list, and frees it
+static void dropEntry(ResultCache *cache, int *slot) {
+    int i = *slot;
+    CacheEntry *entry = &cache->entries[i];
+
+    *slot = entry->chain;
+    unlinkEntry(cache, i);
+    free(entry->key);
+    entry->chain = cache->unused;
+    cache->unused = i;
+}
+
+char *cacheFind(ResultCache *cache, char *key, int keyLen, size_t *length) {
+    int i = *findSlot(cache, key, keyLen);
+
+    if (i == -1) {
+        cache->misses++;
+        return NULL;
+    }
+
+    cache->hits++;
+
+    if (i != cache->newest) {
+        unlinkEntry(cache, i);
+        pushNewest(cache, i);
+    }
+
+    *length = cache->entries[i].length;
+    return cache->entries[i].text;
+}
+
+void cacheStore(ResultCache *cache, char *key, int keyLen, char *text, size_t length) {
+    int *slot = findSlot(cache, key, keyLen);
+
+    if (*slot != -1) dropEntry(cache, slot);
+
+    if (cache->unused == -1) {
+        CacheEntry *oldest = &cache->entries[cache->oldest];
+
+        dropEntry(cache, findSlot(cache, oldest->key, oldest->keyLen));
+    }
+
+    int i = cache->unused;
+    CacheEntry *entry = &cache->entries[i];
+    char *block = malloc(keyLen + length);
+
+    // Caching is only ever an optimization, so a block that cannot be copied is not kept
+    if (block == NULL) return;
+
+    memcpy(block, key, keyLen);
+    memcpy(block + keyLen, text, length);
+    cache->unused = entry->chain;
+    entry->key = block;
+    entry->keyLen = keyLen;
+    entry->text = block + keyLen;
+    entry->length = length;
+
+    slot = &cache->buckets[hashKey(key, keyLen) & cache->bucketMask];
+    entry->chain = *slot;
+    *slot = i;
+    pushNewest(cache, i);
+}
+
+void cacheForget(ResultCache *cache, char *key, int keyLen) {
+    int *slot = findSlot(cache, key, keyLen);
+
+    if (*slot != -1) dropEntry(cache, slot);
+}
+
+void cacheClear(ResultCache *cache) {
+    for (int i = cache->newest; i != -1; i = cache->entries[i].older) {
+        free(cache->entries[i].key);
+    }
+
+    resetCache(cache);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+
+/*
+    A cached answer: the query's whole formatted block, from "Query word:" on, stored
+    in one malloc'd block after a copy of the query itself
+*/
+typedef struct cacheEntry{
+    char *key;
+    int keyLen;
+    char *text;
+    size_t length;
+    int newer;          // neighbours in recency order, -1 at either end
+    int older;
+    int chain;          // next entry in the same hash bucket, or in the free list
+}CacheEntry;
+
+/*
+    A fixed number of query results, the least recently used one making room for a new
+    one when it is full. Entries live in one array and point at each other by index:
+    a hash table chains them by key, and a doubly linked list orders them by use.
+*/
+typedef struct resultCache{
+    CacheEntry *entries;
+    int capacity;
+    int *buckets;
+    int bucketMask;     // bucket count less one, the count being a power of two
+    int newest;
+    int oldest;
+    int unused;         // first free entry
+    long hits;
+    long misses;
+}ResultCache;
+
+// Returns NULL, after reporting it, if capacity entries cannot be allocated
+ResultCache *buildCache(int capacity);
+void freeCache(ResultCache *cache);
+
+// Returns the block cached for key, counting a hit and marking it used, or NULL for a miss
+char *cacheFind(ResultCache *cache, char *key, int keyLen, size_t *length);
+
+// Stores the block for key, evicting the least recently used entry if the cache is full
+void cacheStore(ResultCache *cache, char *key, int keyLen, char *text, size_t length);
+
+// Drops the entry for key, if there is one, once its answer may have changed
+void cacheForget(ResultCache *cache, char *key, int keyLen);
+
+// Drops every entry
+void cacheClear(ResultCache *cache);
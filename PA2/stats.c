@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "stats.h"
+
+static const char *phaseNames[PHASE_COUNT] = {"load", "sort", "index build", "queries"};
+
+static int bucketOf(long long);
+static long long bucketTop(int);
+static long long percentile(QueryStats *, double);
+static void keepWorst(QueryCost *, int *, QueryCost *, int);
+static void reportWorst(FILE *, char *, QueryCost *, int);
+
+
+void statsInit(QueryStats *stats) {
+    memset(stats, 0, sizeof(QueryStats));
+}
+
+long long statsClock(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+void statsPhase(QueryStats *stats, int phase, long long start) {
+    stats->phaseNanos[phase] += statsClock() - start;
+}
+
+// Values below 2^STATS_SUB_BITS get a bucket each; above, each power of two is split evenly
+static int bucketOf(long long nanos) {
+    unsigned long long value = nanos < 0 ? 0 : nanos;
+
+    if (value < (1ULL << STATS_SUB_BITS)) return (int) value;
+
+    int shift = 63 - __builtin_clzll(value) - STATS_SUB_BITS;
+
+    return ((shift + 1) << STATS_SUB_BITS) + (int) ((value >> shift) & ((1 << STATS_SUB_BITS) - 1));
+}
+
+// The largest value that falls in bucket i
+static long long bucketTop(int i) {
+    if (i < (1 << STATS_SUB_BITS)) return i;
+
+    int shift = (i >> STATS_SUB_BITS) - 1;
+    long long low = (long long) ((1 << STATS_SUB_BITS) + (i & ((1 << STATS_SUB_BITS) - 1))) << shift;
+
+    return low + (1LL << shift) - 1;
+}
+
+// The latency fraction of the queries took at most, to the precision of the buckets
+static long long percentile(QueryStats *stats, double fraction) {
+    long long rank = (long long) (fraction * stats->queryCount + 0.999999);
+    long long seen = 0;
+
+    if (rank < 1) rank = 1;
+
+    for (int i = 0; i < STATS_BUCKETS; i++) {
+        seen += stats->counts[i];
+
+        // Never past the slowest query actually seen
+        if (seen >= rank) return bucketTop(i) < stats->slowest[0].nanos ? bucketTop(i) : stats->slowest[0].nanos;
+    }
+
+    return stats->slowest[0].nanos;
+}
+
+/*
+    Keeps the STATS_WORST largest costs in list, largest first, by time or with byScanned
+    set by entries scanned. A repeated query is listed once, at its worst.
+*/
+static void keepWorst(QueryCost *list, int *count, QueryCost *cost, int byScanned) {
+    for (int j = 0; j < *count; j++) {
+        QueryCost *listed = &list[j];
+
+        if (listed->queryLen != cost->queryLen || memcmp(listed->query, cost->query, cost->queryLen) != 0) continue;
+
+        if (byScanned ? listed->scanned >= cost->scanned : listed->nanos >= cost->nanos) return;
+
+        // Worse this time, so it goes back in where it now belongs
+        memmove(listed, listed + 1, sizeof(QueryCost) * (*count - j - 1));
+        (*count)--;
+        break;
+    }
+
+    int i = *count < STATS_WORST ? (*count)++ : STATS_WORST;
+
+    for (; i > 0; i--) {
+        QueryCost *before = &list[i - 1];
+
+        if (byScanned ? before->scanned >= cost->scanned : before->nanos >= cost->nanos) break;
+
+        if (i < STATS_WORST) list[i] = *before;
+    }
+
+    if (i < STATS_WORST) list[i] = *cost;
+}
+
+void statsRecord(QueryStats *stats, char *query, int queryLen, long long nanos, int scanned) {
+    QueryCost cost = {query, queryLen, nanos, scanned};
+
+    stats->counts[bucketOf(nanos)]++;
+    stats->queryCount++;
+    stats->totalNanos += nanos;
+    stats->totalScanned += scanned;
+    keepWorst(stats->slowest, &stats->slowCount, &cost, 0);
+    keepWorst(stats->widest, &stats->wideCount, &cost, 1);
+}
+
+static void reportWorst(FILE *fp, char *title, QueryCost *list, int count) {
+    fprintf(fp, "%s:\n", title);
+
+    for (int i = 0; i < count; i++) {
+        fprintf(fp, "  %10.2fus %8d scanned  %.*s\n", list[i].nanos / 1e3, list[i].scanned, list[i].queryLen, list[i].query);
+    }
+}
+
+void statsReport(QueryStats *stats, FILE *fp) {
+    fprintf(fp, "Phase times:\n");
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        fprintf(fp, "  %-12s%10.3fms\n", phaseNames[i], stats->phaseNanos[i] / 1e6);
+    }
+
+    if (stats->queryCount == 0) {
+        fprintf(fp, "No queries timed; only the serial and -u modes time each one.\n");
+        return;
+    }
+
+    fprintf(fp, "Query latency over %ld queries:\n", stats->queryCount);
+    fprintf(fp, "  mean %.2fus  p50 %.2fus  p99 %.2fus  p999 %.2fus  max %.2fus\n",
+            stats->totalNanos / 1e3 / stats->queryCount, percentile(stats, 0.5) / 1e3,
+            percentile(stats, 0.99) / 1e3, percentile(stats, 0.999) / 1e3, stats->slowest[0].nanos / 1e3);
+    fprintf(fp, "Entries scanned per query: mean %.2f  max %d\n",
+            (double) stats->totalScanned / stats->queryCount, stats->widest[0].scanned);
+    reportWorst(fp, "Slowest queries", stats->slowest, stats->slowCount);
+    reportWorst(fp, "Most scanned queries", stats->widest, stats->wideCount);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdio.h>
+
+// The phases timed by --stats
+#define PHASE_LOAD 0
+#define PHASE_SORT 1
+#define PHASE_BUILD 2
+#define PHASE_QUERY 3
+#define PHASE_COUNT 4
+
+/*
+    Latencies are counted in an HDR-style histogram: every power of two of nanoseconds
+    is split into 2^STATS_SUB_BITS equal buckets, so a percentile read from it is within
+    about 3% of the true one whatever its size
+*/
+#define STATS_SUB_BITS 5
+#define STATS_BUCKETS ((64 - STATS_SUB_BITS + 1) << STATS_SUB_BITS)
+
+// Queries listed among the slowest and among those that scanned the most
+#define STATS_WORST 10
+
+// One query worth listing; the word is a view into the query file
+typedef struct queryCost{
+    char *query;
+    int queryLen;
+    long long nanos;
+    int scanned;
+}QueryCost;
+
+typedef struct queryStats{
+    long long phaseNanos[PHASE_COUNT];
+    long long counts[STATS_BUCKETS];
+    long queryCount;
+    long long totalNanos;
+    long long totalScanned;
+    QueryCost slowest[STATS_WORST];     // longest first
+    int slowCount;
+    QueryCost widest[STATS_WORST];      // most scanned first
+    int wideCount;
+}QueryStats;
+
+void statsInit(QueryStats *stats);
+
+// Monotonic time in nanoseconds
+long long statsClock(void);
+
+// Adds the time since start, as from statsClock, to a phase
+void statsPhase(QueryStats *stats, int phase, long long start);
+
+// Records one query's latency and the dictionary entries it scanned
+void statsRecord(QueryStats *stats, char *query, int queryLen, long long nanos, int scanned);
+
+// Writes the phase times, latency percentiles and worst queries to fp
+void statsReport(QueryStats *stats, FILE *fp);
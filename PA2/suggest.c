@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "suggest.h"
+
+static int canUpdate(Suggester *);
+
+
+Suggester *buildSuggester(Item *dict, int size, int kind) {
+    Suggester *suggester = malloc(sizeof(Suggester));
+
+    if (suggester == NULL) {
+        fprintf(stderr, "Unable to allocate memory for suggester.\n");
+        return NULL;
+    }
+
+    suggester->kind = kind;
+    suggester->maxEdits = 0;
+    suggester->dict = dict;
+    suggester->dictSize = size;
+    suggester->trie = NULL;
+    suggester->range = NULL;
+    suggester->search = NULL;
+
+    if (kind == INDEX_TRIE) {
+        suggester->trie = buildTrie(dict, size);
+    } else if ((suggester->range = buildRangeMax(dict, size)) != NULL) {
+        suggester->search = buildPrefixIndex(dict, size);
+    }
+
+    if (suggester->trie == NULL && suggester->search == NULL) {
+        freeSuggester(suggester);
+        return NULL;
+    }
+
+    return suggester;
+}
+
+void freeSuggester(Suggester *suggester) {
+    if (suggester == NULL) return;
+
+    freeTrie(suggester->trie);
+    freeRangeMax(suggester->range);
+    freePrefixIndex(suggester->search);
+    free(suggester);
+}
+
+int suggest(Suggester *suggester, char *prefix, int prefixLen, int *top) {
+    int scanned;
+
+    return suggestScanned(suggester, prefix, prefixLen, top, &scanned);
+}
+
+int suggestScanned(Suggester *suggester, char *prefix, int prefixLen, int *top, int *scanned) {
+    *scanned = 0;
+
+    if (suggester->kind == INDEX_TRIE && suggester->maxEdits > 0) {
+        return trieFuzzy(suggester->trie, prefix, prefixLen, suggester->maxEdits, top, scanned);
+    }
+
+    if (suggester->kind == INDEX_TRIE) {
+        TrieNode *node = trieFind(suggester->trie, prefix, prefixLen);
+
+        if (node == NULL) return 0;
+
+        memcpy(top, node->top, sizeof(int) * node->topCount);
+        *scanned = node->topCount;
+        return node->topCount;
+    }
+
+    int low = prefixIndexFind(suggester->search, prefix, prefixLen);
+
+    if (low == -1) return 0;
+
+    int high = prefixIndexEnd(suggester->search, prefix, prefixLen);
+
+    return rangeTopK(suggester->range, low, high, top, scanned);
+}
+
+static int canUpdate(Suggester *suggester) {
+    if (suggester->kind == INDEX_TRIE) return 1;
+
+    fprintf(stderr, "Dictionary updates need the trie index.\n");
+    return 0;
+}
+
+int insertWord(Suggester *suggester, char *word, int length, int weight) {
+    if (!canUpdate(suggester)) return -1;
+
+    int result = trieInsert(suggester->trie, word, length, weight);
+
+    suggester->dict = suggester->trie->dict;
+    suggester->dictSize = suggester->trie->dictSize;
+    return result;
+}
+
+int updateWord(Suggester *suggester, char *word, int length, int weight) {
+    if (!canUpdate(suggester)) return -1;
+
+    return trieUpdate(suggester->trie, word, length, weight);
+}
+
+int deleteWord(Suggester *suggester, char *word, int length) {
+    if (!canUpdate(suggester)) return -1;
+
+    return trieDelete(suggester->trie, word, length);
+}
+
+int binSearchItemsH(Item *items, char *target, int targetLen, int low, int high) {
+    int result = -1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int cmpResult = comparePrefix(target, targetLen, &items[mid]);
+
+        if (cmpResult == 0) {
+            result = mid;
+            high = mid - 1;
+        } else if (cmpResult < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return result;
+}
+
+int binSearchItems(Item *items, char *target, int targetLen, int high) {
+    return binSearchItemsH(items, target, targetLen, 0, high - 1);
+}
+
+int binSearchItemsEnd(Item *items, char *target, int targetLen, int low, int high) {
+    int result = high + 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+
+        // Words starting with target come before every larger word, so this is a clean split
+        if (comparePrefix(target, targetLen, &items[mid]) < 0) {
+            result = mid;
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return result;
+}
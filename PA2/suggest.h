@@ -0,0 +1,60 @@
+#pragma once
+
+#include "item.h"
+#include "trie.h"
+#include "rangeMax.h"
+#include "prefixIndex.h"
+
+// How the top suggestions for a prefix are found
+#define INDEX_TRIE 0
+#define INDEX_RANGE 1
+
+/*
+    Answers prefix queries over the alphabetically sorted dictionary, either from the
+    completion trie or by finding the prefix range in the Eytzinger search index and
+    asking the range-max table for its heaviest words. The trie is faster; the table
+    takes less memory.
+*/
+typedef struct suggester{
+    int kind;
+    int maxEdits;       // above 0, queries are fuzzy as in trieFuzzy; the trie only
+    Item *dict;
+    int dictSize;
+    Trie *trie;
+    RangeMax *range;
+    PrefixIndex *search;
+}Suggester;
+
+// The dictionary must already be sorted by word, and must outlive the suggester
+Suggester *buildSuggester(Item *dict, int size, int kind);
+void freeSuggester(Suggester *suggester);
+
+/*
+    Fills top with the dictionary indices of the TOP_K heaviest words starting with
+    prefix, heaviest first and ties broken alphabetically; returns how many, 0 if none.
+    With maxEdits set, prefixes that many edits off count too, ranked after closer ones.
+*/
+int suggest(Suggester *suggester, char *prefix, int prefixLen, int *top);
+
+/*
+    suggest, also storing in *scanned how many dictionary entries it ranked to find
+    them: a trie node's stored list, the range index's probes, or a fuzzy walk's offers
+*/
+int suggestScanned(Suggester *suggester, char *prefix, int prefixLen, int *top, int *scanned);
+
+/*
+    Online updates, as trieInsert and the rest; only the trie supports them, so with the
+    range index they report that and return -1. An insert may move the dictionary, after
+    which suggester->dict is the array to use, and to free.
+*/
+int insertWord(Suggester *suggester, char *word, int length, int weight);
+int updateWord(Suggester *suggester, char *word, int length, int weight);
+int deleteWord(Suggester *suggester, char *word, int length);
+
+/*
+    binSearchItems returns the leftmost word starting with target, or -1;
+    binSearchItemsEnd returns one past the last such word in [low, high]
+*/
+int binSearchItemsH(Item *items, char *target, int targetLen, int low, int high);
+int binSearchItems(Item *items, char *target, int targetLen, int high);
+int binSearchItemsEnd(Item *items, char *target, int targetLen, int low, int high);
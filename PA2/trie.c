@@ -0,0 +1,671 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trie.h"
+
+/*
+    A fuzzy query's walk. Row r of rows holds the automaton's state after a prefix of
+    length r: entry j is the edit distance between it and the first j query bytes,
+    capped at one past reach. levels[d] ranks the heaviest words within d edits the way
+    a node's top list does.
+*/
+typedef struct fuzzyWalk{
+    char *query;
+    int queryLen;
+    int reach;          // the most edits still worth finding a match at
+    int scanned;
+    unsigned char *rows;
+    TrieNode levels[MAX_EDITS + 1];
+}FuzzyWalk;
+
+static int newNodes(Trie *, int);
+static int newBlock(Trie *, int);
+static int growDict(Trie *);
+static int commonPrefix(Item *, Item *, int);
+static int ranksAbove(Trie *, int, int);
+static void offerTop(Trie *, TrieNode *, int);
+static void rankNode(Trie *, TrieNode *);
+static int buildNode(Trie *, int, int, int, int);
+static int findChild(Trie *, TrieNode *, unsigned char);
+static void makeLeaf(Trie *, int, int, unsigned char);
+static int addChild(Trie *, int, int);
+static int splitNode(Trie *, int, int, int);
+static int placeWord(Trie *, int);
+static int holdsWord(Trie *, TrieNode *, char *, int);
+static int refreshPath(Trie *, int, char *, int);
+static void offerLevels(Trie *, FuzzyWalk *, TrieNode *, int, int);
+static int worthWalking(Trie *, FuzzyWalk *, TrieNode *, int, int);
+static void fuzzyNode(Trie *, FuzzyWalk *, int, int, int, int);
+
+
+// Reserves count contiguous nodes and returns the index of the first, or -1
+static int newNodes(Trie *trie, int count) {
+    if (trie->nodeCount + count > trie->nodeCapacity) {
+        int capacity = trie->nodeCapacity * 2;
+
+        if (capacity < trie->nodeCount + count) capacity = trie->nodeCount + count;
+
+        TrieNode *nodes = realloc(trie->nodes, sizeof(TrieNode) * capacity);
+
+        if (nodes == NULL) return -1;
+
+        trie->nodes = nodes;
+        trie->nodeCapacity = capacity;
+    }
+
+    int first = trie->nodeCount;
+    trie->nodeCount += count;
+    return first;
+}
+
+// Reuses a child block of count nodes that addChild left behind if there is one, else reserves it
+static int newBlock(Trie *trie, int count) {
+    int block = trie->unusedBlock[count];
+
+    if (block == -1) return newNodes(trie, count);
+
+    trie->unusedBlock[count] = trie->nodes[block].firstChild;
+    return block;
+}
+
+// Makes room for more inserted words; the dictionary and its chains grow together
+static int growDict(Trie *trie) {
+    int capacity = trie->dictCapacity < 512 ? 1024 : trie->dictCapacity * 2;
+    Item *dict = realloc(trie->dict, sizeof(Item) * capacity);
+
+    if (dict == NULL) return -1;
+
+    trie->dict = dict;
+
+    int *sameWord = realloc(trie->sameWord, sizeof(int) * capacity);
+
+    if (sameWord == NULL) return -1;
+
+    trie->sameWord = sameWord;
+    trie->dictCapacity = capacity;
+    return 0;
+}
+
+// Length of the common prefix of two words already known to share their first from bytes
+static int commonPrefix(Item *a, Item *b, int from) {
+    int i = from;
+
+    while (i < a->length && i < b->length && a->word[i] == b->word[i]) i++;
+
+    return i;
+}
+
+// heavier, except that inserted words sit past the sorted ones and so tie by their spelling
+static int ranksAbove(Trie *trie, int a, int b) {
+    Item *dict = trie->dict;
+
+    if (dict[a].weight != dict[b].weight || (a < trie->sortedSize && b < trie->sortedSize)) {
+        return heavier(dict, a, b);
+    }
+
+    return compareWords(dict[a].word, dict[a].length, dict[b].word, dict[b].length) < 0;
+}
+
+// Inserts a word into a node's top list if it is heavy enough to belong there
+static void offerTop(Trie *trie, TrieNode *node, int index) {
+    int i = node->topCount;
+
+    if (i == TOP_K) {
+        if (!ranksAbove(trie, index, node->top[TOP_K - 1])) return;
+        i--;
+    } else {
+        node->topCount++;
+    }
+
+    for (; i > 0 && ranksAbove(trie, index, node->top[i - 1]); i--) {
+        node->top[i] = node->top[i - 1];
+    }
+
+    node->top[i] = index;
+}
+
+// The heaviest words under a node are among its own words and its children's tops
+static void rankNode(Trie *trie, TrieNode *node) {
+    node->topCount = 0;
+
+    for (int j = node->terminal; j >= 0; j = trie->sameWord[j]) {
+        offerTop(trie, node, j);
+    }
+
+    for (int child = node->firstChild; child < node->firstChild + node->childCount; child++) {
+        TrieNode *c = &trie->nodes[child];
+
+        for (int j = 0; j < c->topCount; j++) {
+            offerTop(trie, node, c->top[j]);
+        }
+    }
+}
+
+/*
+    Fills in node for the words [low, high), which share at least their first shared bytes.
+    Node indices are used instead of pointers since growing the pool may move it.
+*/
+static int buildNode(Trie *trie, int node, int low, int high, int shared) {
+    Item *dict = trie->dict;
+    int depth = commonPrefix(&dict[low], &dict[high - 1], shared);
+    int i = low;
+
+    // Words that end right here sort ahead of every longer word
+    while (i < high && dict[i].length == depth) i++;
+
+    int rest = i;
+    int childCount = 0;
+
+    for (int j = rest; j < high; j++) {
+        if (j == rest || dict[j].word[depth] != dict[j - 1].word[depth]) childCount++;
+    }
+
+    int firstChild = newNodes(trie, childCount);
+
+    if (firstChild < 0) return -1;
+
+    TrieNode *n = &trie->nodes[node];
+    n->low = low;
+    n->high = high;
+    n->depth = depth;
+    n->firstChild = firstChild;
+    n->childCount = childCount;
+    n->terminal = rest > low ? low : -1;
+
+    for (int j = low; j < rest; j++) {
+        trie->sameWord[j] = j + 1 < rest ? j + 1 : -1;
+    }
+
+    for (int child = firstChild; i < high; child++) {
+        int end = i + 1;
+
+        while (end < high && dict[end].word[depth] == dict[i].word[depth]) end++;
+
+        trie->nodes[child].first = (unsigned char) dict[i].word[depth];
+
+        if (buildNode(trie, child, i, end, depth + 1) < 0) return -1;
+
+        i = end;
+    }
+
+    rankNode(trie, &trie->nodes[node]);
+    return 0;
+}
+
+Trie *buildTrie(Item *dict, int size) {
+    Trie *trie = malloc(sizeof(Trie));
+
+    if (trie == NULL) {
+        fprintf(stderr, "Unable to allocate memory for trie.\n");
+        return NULL;
+    }
+
+    trie->dict = dict;
+    trie->dictSize = size;
+    trie->dictCapacity = size;
+    trie->sortedSize = size;
+    trie->sameWord = malloc(sizeof(int) * (size + 1));
+    trie->unusedWord = -1;
+    trie->nodes = NULL;
+    trie->nodeCount = 0;
+    trie->nodeCapacity = 0;
+
+    for (int i = 0; i <= TRIE_FANOUT; i++) {
+        trie->unusedBlock[i] = -1;
+    }
+
+    if (trie->sameWord == NULL || (size > 0 && (newNodes(trie, 1) < 0 || buildNode(trie, 0, 0, size, 0) < 0))) {
+        fprintf(stderr, "Unable to allocate memory for trie.\n");
+        freeTrie(trie);
+        return NULL;
+    }
+
+    return trie;
+}
+
+void freeTrie(Trie *trie) {
+    if (trie == NULL) return;
+
+    free(trie->sameWord);
+    free(trie->nodes);
+    free(trie);
+}
+
+// Binary searches a node's children for the one its next byte leads into; returns its index, or -1
+static int findChild(Trie *trie, TrieNode *node, unsigned char next) {
+    TrieNode *children = trie->nodes + node->firstChild;
+    int low = 0;
+    int high = node->childCount - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+
+        if (children[mid].first == next) {
+            return node->firstChild + mid;
+        } else if (children[mid].first < next) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    return -1;
+}
+
+TrieNode *trieFind(Trie *trie, char *prefix, int prefixLen) {
+    if (trie->nodeCount == 0) return NULL;
+
+    TrieNode *node = trie->nodes;
+    int matched = 0;
+
+    while (1) {
+        // Every word under the node spells out its label, so the first one will do
+        int end = node->depth < prefixLen ? node->depth : prefixLen;
+
+        if (memcmp(prefix + matched, trie->dict[node->low].word + matched, end - matched) != 0) return NULL;
+
+        if (end == prefixLen) return node;
+
+        matched = end;
+
+        int child = findChild(trie, node, (unsigned char) prefix[matched]);
+
+        if (child < 0) return NULL;
+
+        node = &trie->nodes[child];
+    }
+}
+
+// Turns the node at slot into a leaf holding just the word at index entry
+static void makeLeaf(Trie *trie, int slot, int entry, unsigned char first) {
+    TrieNode *leaf = &trie->nodes[slot];
+
+    leaf->low = entry;
+    leaf->high = entry + 1;
+    leaf->depth = trie->dict[entry].length;
+    leaf->firstChild = 0;
+    leaf->childCount = 0;
+    leaf->terminal = entry;
+    leaf->topCount = 0;
+    leaf->first = first;
+    trie->sameWord[entry] = -1;
+}
+
+/*
+    Gives a node a new leaf child for entry. Children have to stay contiguous, so unless
+    they already end the pool, where they can just grow, they are copied to a block one
+    larger and their old one is kept for the next node to need that many.
+*/
+static int addChild(Trie *trie, int node, int entry) {
+    int count = trie->nodes[node].childCount;
+    int block = trie->nodes[node].firstChild;
+
+    if (count > 0 && block + count == trie->nodeCount) {
+        if (newNodes(trie, 1) < 0) return -1;
+    } else {
+        if ((block = newBlock(trie, count + 1)) < 0) return -1;
+
+        int old = trie->nodes[node].firstChild;
+
+        memcpy(&trie->nodes[block], &trie->nodes[old], sizeof(TrieNode) * count);
+
+        if (count > 0) {
+            trie->nodes[old].firstChild = trie->unusedBlock[count];
+            trie->unusedBlock[count] = old;
+        }
+    }
+
+    TrieNode *n = &trie->nodes[node];
+    TrieNode *children = trie->nodes + block;
+    unsigned char first = (unsigned char) trie->dict[entry].word[n->depth];
+    int i = count;
+
+    for (; i > 0 && children[i - 1].first > first; i--) {
+        children[i] = children[i - 1];
+    }
+
+    makeLeaf(trie, block + i, entry, first);
+    n->firstChild = block;
+    n->childCount = count + 1;
+    return 0;
+}
+
+/*
+    Cuts a node's label short at depth, where entry's word leaves it. The node keeps its
+    slot, so its parent need not change, and what it was moves down to become its child,
+    next to a new leaf for entry unless the word ends right at depth.
+*/
+static int splitNode(Trie *trie, int node, int depth, int entry) {
+    Item *item = &trie->dict[entry];
+    int count = item->length > depth ? 2 : 1;
+    int block = newNodes(trie, count);
+
+    if (block < 0) return -1;
+
+    TrieNode *n = &trie->nodes[node];
+    unsigned char below = (unsigned char) trie->dict[n->low].word[depth];
+    int moved = block;
+
+    if (count == 2) {
+        unsigned char first = (unsigned char) item->word[depth];
+
+        if (first < below) moved++;
+
+        makeLeaf(trie, moved == block ? block + 1 : block, entry, first);
+    }
+
+    trie->nodes[moved] = *n;
+    trie->nodes[moved].first = below;
+    n->depth = depth;
+    n->firstChild = block;
+    n->childCount = count;
+    n->terminal = -1;
+
+    if (count == 1) {
+        n->terminal = entry;
+        trie->sameWord[entry] = -1;
+    }
+
+    return 0;
+}
+
+// Hangs the word at index entry in the tree; returns 1 if it is already there
+static int placeWord(Trie *trie, int entry) {
+    Item *item = &trie->dict[entry];
+
+    if (trie->nodeCount == 0) {
+        if (newNodes(trie, 1) < 0) return -1;
+
+        makeLeaf(trie, 0, entry, 0);
+        return 0;
+    }
+
+    int node = 0;
+    int matched = 0;
+
+    while (1) {
+        TrieNode *n = &trie->nodes[node];
+        int shared = commonPrefix(item, &trie->dict[n->low], matched);
+
+        if (shared < n->depth) return splitNode(trie, node, shared, entry);
+
+        if (item->length == n->depth) {
+            if (n->terminal >= 0) return 1;
+
+            n->terminal = entry;
+            trie->sameWord[entry] = -1;
+            return 0;
+        }
+
+        int child = findChild(trie, n, (unsigned char) item->word[n->depth]);
+
+        if (child < 0) return addChild(trie, node, entry);
+
+        node = child;
+        matched = n->depth + 1;
+    }
+}
+
+static int holdsWord(Trie *trie, TrieNode *node, char *word, int length) {
+    for (int i = 0; i < node->topCount; i++) {
+        Item *item = &trie->dict[node->top[i]];
+
+        if (item->length == length && memcmp(item->word, word, length) == 0) return 1;
+    }
+
+    return 0;
+}
+
+/*
+    Reranks the nodes from word's node back up to node after the word changed. A node
+    whose top list the word was in neither before nor after keeps the same list, and so
+    then does every node above it, which is where this stops. Returns whether it did not.
+*/
+static int refreshPath(Trie *trie, int node, char *word, int length) {
+    TrieNode *n = &trie->nodes[node];
+
+    if (n->depth < length) {
+        int child = findChild(trie, n, (unsigned char) word[n->depth]);
+
+        if (child < 0 || !refreshPath(trie, child, word, length)) return 0;
+    }
+
+    int held = holdsWord(trie, n, word, length);
+
+    rankNode(trie, n);
+    return held || holdsWord(trie, n, word, length);
+}
+
+int trieInsert(Trie *trie, char *word, int length, int weight) {
+    TrieNode *node = trieFind(trie, word, length);
+
+    if (node != NULL && node->depth == length) {
+        if (node->terminal >= 0) return 1;
+
+        // A deleted word still spells out its node's label, so it comes back in place
+        if (node->terminal == DELETED_WORD) {
+            node->terminal = node->low;
+            trie->sameWord[node->low] = -1;
+            trie->dict[node->low].weight = weight;
+            refreshPath(trie, 0, word, length);
+            return 0;
+        }
+    }
+
+    int entry = trie->unusedWord;
+
+    if (entry == -1) {
+        if (trie->dictSize == trie->dictCapacity && growDict(trie) < 0) {
+            fprintf(stderr, "Unable to allocate memory for trie.\n");
+            return -1;
+        }
+
+        entry = trie->dictSize;
+    } else {
+        trie->unusedWord = trie->sameWord[entry];
+    }
+
+    Item *item = &trie->dict[entry];
+
+    item->word = word;
+    item->length = length;
+    item->weight = weight;
+
+    if (placeWord(trie, entry) < 0) {
+        fprintf(stderr, "Unable to allocate memory for trie.\n");
+
+        if (entry < trie->dictSize) {
+            trie->sameWord[entry] = trie->unusedWord;
+            trie->unusedWord = entry;
+        }
+
+        return -1;
+    }
+
+    if (entry == trie->dictSize) trie->dictSize++;
+
+    refreshPath(trie, 0, word, length);
+    return 0;
+}
+
+int trieUpdate(Trie *trie, char *word, int length, int weight) {
+    TrieNode *node = trieFind(trie, word, length);
+
+    if (node == NULL || node->depth != length || node->terminal < 0) return 1;
+
+    for (int j = node->terminal; j != -1; j = trie->sameWord[j]) {
+        trie->dict[j].weight = weight;
+    }
+
+    refreshPath(trie, 0, word, length);
+    return 0;
+}
+
+/*
+    The word at the node's low has to stay, since it spells out the label, and comes back
+    if the word is inserted again. Any other inserted slot goes on the free list; sorted
+    slots do not, since their index is their place in the order.
+*/
+int trieDelete(Trie *trie, char *word, int length) {
+    TrieNode *node = trieFind(trie, word, length);
+
+    if (node == NULL || node->depth != length || node->terminal < 0) return 1;
+
+    int kept = -1;
+
+    for (int j = node->terminal, next; j != -1; j = next) {
+        next = trie->sameWord[j];
+
+        if (j == node->low) {
+            kept = DELETED_WORD;
+        } else if (j >= trie->sortedSize) {
+            trie->sameWord[j] = trie->unusedWord;
+            trie->unusedWord = j;
+        }
+    }
+
+    node->terminal = kept;
+    refreshPath(trie, 0, word, length);
+    return 0;
+}
+
+/*
+    Every word under node is within edits of the query, and was not within fewer before.
+    Once a level is full, nothing further away can reach the answer.
+*/
+static void offerLevels(Trie *trie, FuzzyWalk *walk, TrieNode *node, int edits, int before) {
+    for (int d = edits; d < before && d <= walk->reach; d++) {
+        for (int i = 0; i < node->topCount; i++) {
+            offerTop(trie, &walk->levels[d], node->top[i]);
+        }
+
+        walk->scanned += node->topCount;
+
+        if (walk->levels[d].topCount == TOP_K) walk->reach = d;
+    }
+}
+
+/*
+    Whether words under node may still make the answer, given that none is fewer than
+    lowest edits away. Every level from lowest up has seen at least the words lowest
+    has, so a node whose heaviest word misses a full list at lowest misses them all.
+*/
+static int worthWalking(Trie *trie, FuzzyWalk *walk, TrieNode *node, int lowest, int best) {
+    if (lowest >= best || lowest > walk->reach || node->topCount == 0) return 0;
+
+    TrieNode *level = &walk->levels[lowest];
+
+    return level->topCount < TOP_K || ranksAbove(trie, node->top[0], level->top[TOP_K - 1]);
+}
+
+/*
+    Feeds node's label from byte from on through the automaton, starting from the row
+    for the prefix of length from, whose smallest entry is lowest; best is the fewest
+    edits the path matched at so far
+*/
+static void fuzzyNode(Trie *trie, FuzzyWalk *walk, int node, int from, int lowest, int best) {
+    TrieNode *n = &trie->nodes[node];
+    char *label = trie->dict[n->low].word;
+    int width = walk->queryLen + 1;
+
+    if (!worthWalking(trie, walk, n, lowest, best)) return;
+
+    for (int at = from; at < n->depth; at++) {
+        int cap = walk->reach + 1;
+        unsigned char *last = walk->rows + at * width;
+        unsigned char *row = last + width;
+
+        lowest = row[0] = at + 1 < cap ? at + 1 : cap;
+
+        for (int j = 1; j < width; j++) {
+            int edits = last[j - 1] + (walk->query[j - 1] != label[at]);
+
+            if (last[j] + 1 < edits) edits = last[j] + 1;
+            if (row[j - 1] + 1 < edits) edits = row[j - 1] + 1;
+
+            row[j] = edits < cap ? edits : cap;
+
+            if (row[j] < lowest) lowest = row[j];
+        }
+
+        if (row[width - 1] < best) {
+            offerLevels(trie, walk, n, row[width - 1], best);
+            best = row[width - 1];
+        }
+
+        // A longer prefix is never fewer edits away than the row's smallest entry
+        if (!worthWalking(trie, walk, n, lowest, best)) return;
+    }
+
+    for (int child = n->firstChild; child < n->firstChild + n->childCount; child++) {
+        fuzzyNode(trie, walk, child, n->depth, lowest, best);
+    }
+}
+
+int trieFuzzy(Trie *trie, char *prefix, int prefixLen, int maxEdits, int *top, int *scanned) {
+    TrieNode *exact = trieFind(trie, prefix, prefixLen);
+
+    if (scanned != NULL) *scanned = 0;
+
+    // A full list of exact matches leaves no room for anything fuzzier
+    if (exact != NULL && exact->topCount == TOP_K) {
+        memcpy(top, exact->top, sizeof(exact->top));
+
+        if (scanned != NULL) *scanned = TOP_K;
+
+        return TOP_K;
+    }
+
+    if (trie->nodeCount == 0) return 0;
+
+    // Paths are cut off by the time a prefix is maxEdits longer than the query
+    FuzzyWalk walk;
+    int width = prefixLen + 1;
+
+    walk.query = prefix;
+    walk.queryLen = prefixLen;
+    walk.reach = maxEdits;
+    walk.scanned = 0;
+    walk.rows = malloc((size_t) width * (prefixLen + maxEdits + 2));
+
+    if (walk.rows == NULL) {
+        fprintf(stderr, "Unable to allocate memory for fuzzy query.\n");
+        return 0;
+    }
+
+    for (int d = 0; d <= maxEdits; d++) {
+        walk.levels[d].topCount = 0;
+    }
+
+    for (int j = 0; j < width; j++) {
+        walk.rows[j] = j < maxEdits + 1 ? j : maxEdits + 1;
+    }
+
+    // The empty prefix is as many edits away as the query is long
+    int best = maxEdits + 1;
+
+    if (prefixLen <= maxEdits) {
+        offerLevels(trie, &walk, trie->nodes, prefixLen, best);
+        best = prefixLen;
+    }
+
+    fuzzyNode(trie, &walk, 0, 0, 0, best);
+    free(walk.rows);
+
+    if (scanned != NULL) *scanned = walk.scanned;
+
+    // Closest first: each level adds its heaviest words not already taken
+    int count = 0;
+
+    for (int d = 0; d <= walk.reach && count < TOP_K; d++) {
+        for (int i = 0; i < walk.levels[d].topCount && count < TOP_K; i++) {
+            int j = 0;
+
+            while (j < count && top[j] != walk.levels[d].top[i]) j++;
+
+            if (j == count) top[count++] = walk.levels[d].top[i];
+        }
+    }
+
+    return count;
+}
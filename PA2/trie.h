@@ -0,0 +1,81 @@
+#pragma once
+
+#include "item.h"
+
+// Most edits a fuzzy query may be away from the prefixes it matches
+#define MAX_EDITS 2
+
+// Most children a node can have, one for each byte
+#define TRIE_FANOUT 256
+
+// A node's terminal once its word is deleted; the word at low is revived if it comes back
+#define DELETED_WORD -2
+
+/*
+    A radix tree over the alphabetically sorted dictionary. Every node stands for the
+    prefix its words share, and since the dictionary is sorted those words are always the
+    contiguous range [low, high). Each node keeps the dictionary indices of its TOP_K
+    heaviest words, heaviest first, so a query only has to find its node.
+
+    Words inserted later take the slot of a deleted one or are appended to the
+    dictionary instead, so low and high only hold for the trie as built; low always
+    names some word under the node, or one deleted from it, and that word spells out
+    the node's label.
+*/
+typedef struct trieNode{
+    int low;
+    int high;
+    int depth;          // length of the prefix shared by the words in [low, high)
+    int firstChild;     // children sit next to each other in the node pool, in byte order
+    int childCount;
+    int terminal;       // first word ending right at this node, -1 if none, or DELETED_WORD
+    int topCount;
+    int top[TOP_K];
+    unsigned char first; // byte that leads from the parent into this node
+}TrieNode;
+
+typedef struct trie{
+    Item *dict;
+    int dictSize;
+    int dictCapacity;
+    int sortedSize;     // words before this index are the sorted ones the trie was built from
+    int *sameWord;      // the next word spelled like word i, or -1, chaining a node's terminals
+    int unusedWord;     // first inserted slot freed by a delete, chained through sameWord, or -1
+    TrieNode *nodes;
+    int nodeCount;
+    int nodeCapacity;
+    int unusedBlock[TRIE_FANOUT + 1]; // child blocks left by addChild, by size, chained through firstChild
+}Trie;
+
+/*
+    The dictionary must already be sorted by word, and must outlive the trie. It has to
+    be malloc'd if words are to be inserted, since that may move it: trie->dict is then
+    the array to use, and to free.
+*/
+Trie *buildTrie(Item *dict, int size);
+void freeTrie(Trie *trie);
+
+/*
+    Online updates. Each changes the words under one path from the root and refreshes
+    the top lists along it, bottom up, stopping at the first node whose list neither
+    held nor now holds the word. Inserted words are views like the rest, so they must
+    outlive the trie. Each returns 0, 1 if the word was already there for an insert or
+    missing otherwise, or -1 if memory ran out; a word given more than once in the
+    dictionary is updated or deleted as a whole.
+*/
+int trieInsert(Trie *trie, char *word, int length, int weight);
+int trieUpdate(Trie *trie, char *word, int length, int weight);
+int trieDelete(Trie *trie, char *word, int length);
+
+// Returns the node whose words all start with prefix, or NULL if no word does
+TrieNode *trieFind(Trie *trie, char *prefix, int prefixLen);
+
+/*
+    Fuzzy lookup: fills top with up to TOP_K words having some prefix at most maxEdits
+    edits (insertions, deletions, substitutions) away from prefix, closest first, then
+    heaviest, then alphabetical, so exact matches lead; returns how many. The trie is
+    walked in lockstep with a Levenshtein automaton whose states are edit distance
+    rows, giving up on a path as soon as no longer prefix could match more closely.
+    scanned, if not NULL, gets how many top list entries the walk ranked.
+*/
+int trieFuzzy(Trie *trie, char *prefix, int prefixLen, int maxEdits, int *top, int *scanned);
@@ -0,0 +1,86 @@
+#include "wordSort.h"
+
+static int byteAt(Item *, int);
+static void swapItems(Item *, int, int);
+static void insertionSort(Item *, int, int);
+static int medianOfThree(Item *, int, int, int, int);
+static void multikeySortH(Item *, int, int);
+
+
+// The byte at depth shifted up by one, so that a word which has ended sorts first
+static int byteAt(Item *item, int depth) {
+    return depth < item->length ? (unsigned char) item->word[depth] + 1 : 0;
+}
+
+static void swapItems(Item *items, int i, int j) {
+    Item temp = items[i];
+    items[i] = items[j];
+    items[j] = temp;
+}
+
+// Sorts words that are already known to share their first depth bytes
+static void insertionSort(Item *items, int size, int depth) {
+    for (int i = 1; i < size; i++) {
+        Item item = items[i];
+        int j = i;
+
+        for (; j > 0 && compareWords(item.word + depth, item.length - depth, items[j - 1].word + depth, items[j - 1].length - depth) < 0; j--) {
+            items[j] = items[j - 1];
+        }
+
+        items[j] = item;
+    }
+}
+
+static int medianOfThree(Item *items, int a, int b, int c, int depth) {
+    int x = byteAt(&items[a], depth);
+    int y = byteAt(&items[b], depth);
+    int z = byteAt(&items[c], depth);
+
+    if (x < y) {
+        if (y < z) return b;
+        return x < z ? c : a;
+    }
+
+    if (x < z) return a;
+    return y < z ? c : b;
+}
+
+static void multikeySortH(Item *items, int size, int depth) {
+    while (size > INSERTION_CUTOFF) {
+        swapItems(items, 0, medianOfThree(items, 0, size / 2, size - 1, depth));
+
+        // Three-way partition on the byte at depth: [0, lt) smaller, [lt, gt) equal, [gt, size) larger
+        int pivot = byteAt(&items[0], depth);
+        int lt = 0;
+        int gt = size;
+
+        for (int i = 1; i < gt;) {
+            int b = byteAt(&items[i], depth);
+
+            if (b < pivot) {
+                swapItems(items, lt++, i++);
+            } else if (b > pivot) {
+                swapItems(items, i, --gt);
+            } else {
+                i++;
+            }
+        }
+
+        multikeySortH(items, lt, depth);
+        multikeySortH(items + gt, size - gt, depth);
+
+        // Words that all ended at depth are equal; otherwise the equal range moves on a byte
+        if (pivot == 0) return;
+
+        items += lt;
+        size = gt - lt;
+        depth++;
+    }
+
+    insertionSort(items, size, depth);
+}
+
+void multikeySort(Item *items, int size) {
+    multikeySortH(items, size, 0);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "item.h"
+
+// Ranges this short or shorter are finished by insertion sort
+#define INSERTION_CUTOFF 16
+
+/*
+    Sorts items alphabetically by word with multikey (three-way radix) quicksort: each
+    pass partitions on a single byte, so a prefix shared by many words is read once per
+    partition instead of once per string comparison. Gives the same order as strcmp.
+*/
+void multikeySort(Item *items, int size);